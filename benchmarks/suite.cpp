@@ -0,0 +1,328 @@
+// the benchmark suite: every algorithm of the notes on seeded synthetic
+// inputs, in one run, with machine readable output
+//
+// g++ suite.cpp -std=c++14 -O2 -pthread
+// ./a.out [--scale 16] [--threads <hardware threads>] [--repeat 3]
+//         [--only bfs,scc,...] [--csv out.csv] [--json out.json]
+//
+// suites: bfs dfs scc toposort sssp mst heap maxsub
+//
+// Inputs, n = 2^scale vertices:
+//   rmat     R-MAT (Kronecker), 16n edges, skewed degrees
+//   er       Erdos-Renyi, 16n edges
+//   grid     sqrt(n) x sqrt(n) 2D grid, edges both ways
+//   chain    the path 0 -> n-1 (a cycle for scc)
+//   dag      random DAG, 8n edges
+// the weights are uniform in [1, 1000].  The heaps push and pop 16n random
+// keys, the max subarray kernels run on 256n random price changes.
+//
+// Every row is one measurement, best of --repeat runs: the time, the rate
+// (edges per second for the graphs, i.e. TEPS, elements or operations for
+// the others) and the peak resident memory of the process so far.  The
+// parallel algorithms are measured with 1, 2, 4... --threads threads.
+// --csv and --json write all the rows, to compare two versions run both
+// with the same arguments and join on (suite, algorithm, input, threads).
+
+#include "../divide-and-conquer/max-subarray.hpp"
+#include "../graph/basics/bfs.hpp"
+#include "../graph/basics/csr.hpp"
+#include "../graph/basics/dfs.hpp"
+#include "../graph/basics/generators.hpp"
+#include "../graph/basics/scc.hpp"
+#include "../graph/basics/toposort.hpp"
+#include "../graph/minimum-spanning-tree/mst.hpp"
+#include "../graph/single-source-shortest-path/bellman-ford.hpp"
+#include "../graph/single-source-shortest-path/sssp.hpp"
+#include "../tree/heap/fibonacci-heap.hpp"
+#include "../tree/heap/heap.hpp"
+#include "../tree/heap/pairing-heap.hpp"
+#include "../tree/heap/radix-heap.hpp"
+#include "../util/bench.hpp"
+#include "../util/parallel.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::divide_and_conquer;
+using namespace clrs::graph;
+using namespace clrs::tree;
+using namespace clrs::util;
+
+using W = long long;
+
+struct options {
+  int scale = 16;
+  int threads = hardware_threads();
+  int repeat = 3;
+  set<string> only;
+  string csv, json;
+};
+
+class suite {
+public:
+  explicit suite(const options &o) : _o(o) {
+    for (int t = 1;; t = min(2 * t, o.threads)) {
+      _thread_counts.push_back(t);
+      if (t == o.threads)
+        break;
+    }
+  }
+
+  bool wanted(const string &name) const {
+    return _o.only.empty() || _o.only.count(name);
+  }
+
+  // times f, best of repeat, and logs it
+  template <class F>
+  void measure(const string &name, const string &algorithm,
+               const string &input, int threads, double items, F &&f) {
+    double t = best_time(_o.repeat, f);
+    log.add(name, algorithm, input, threads, t, items);
+    bench_log::print(log.rows.back());
+    fflush(stdout);
+  }
+
+  // f(pool) for each thread count
+  template <class F>
+  void scaling(const string &name, const string &algorithm,
+               const string &input, double items, F &&f) {
+    for (int t : _thread_counts) {
+      thread_pool pool(t);
+      measure(name, algorithm, input, t, items, [&] { f(pool); });
+    }
+  }
+
+  bench_log log;
+
+private:
+  const options &_o;
+  vector<int> _thread_counts;
+};
+
+template <class G> int max_degree_vertex(const G &g) {
+  int s = 0;
+  for (int v = 0; v < g.num_vertices(); ++v)
+    if (g.degree(v) > g.degree(s))
+      s = v;
+  return s;
+}
+
+// the results the compiler would otherwise see as unused
+volatile size_t sink;
+
+struct input {
+  string name;
+  int n;
+  vector<edge> edges;
+};
+
+int main(int argc, char **argv) {
+  options o;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    string flag = argv[i], value = argv[i + 1];
+    if (flag == "--scale")
+      o.scale = atoi(value.c_str());
+    else if (flag == "--threads")
+      o.threads = max(1, atoi(value.c_str()));
+    else if (flag == "--repeat")
+      o.repeat = max(1, atoi(value.c_str()));
+    else if (flag == "--csv")
+      o.csv = value;
+    else if (flag == "--json")
+      o.json = value;
+    else if (flag == "--only") {
+      stringstream names(value);
+      for (string name; getline(names, name, ',');)
+        o.only.insert(name);
+    } else {
+      cerr << "unknown option " << flag << "\n";
+      return 1;
+    }
+  }
+  suite s(o);
+  const int n = 1 << o.scale, side = static_cast<int>(sqrt(double(n)));
+  const string sc = "-" + to_string(o.scale);
+  vector<input> graphs = {
+      {"rmat" + sc, n, rmat_edges(o.scale, 16, 1)},
+      {"er" + sc, n, erdos_renyi_edges(n, 16LL * n, 2)},
+      {"grid" + sc, side * side, grid_edges(side, side)},
+      {"chain" + sc, n, chain_edges(n)}};
+  bench_log::print_header();
+
+  if (s.wanted("bfs"))
+    for (auto &in : graphs) {
+      csr_graph g(in.n, in.edges);
+      auto gt = transpose(g);
+      int src = max_degree_vertex(g);
+      double m = g.num_edges();
+      s.measure("bfs", "bfs", in.name, 1, m, [&] { bfs(g, src); });
+      s.measure("bfs", "direction_optimizing_bfs", in.name, 1, m,
+                [&] { direction_optimizing_bfs(g, gt, src); });
+      s.scaling("bfs", "parallel_bfs", in.name, m,
+                [&](thread_pool &pool) { parallel_bfs(g, src, pool); });
+    }
+
+  if (s.wanted("dfs"))
+    for (auto &in : graphs) {
+      csr_graph g(in.n, in.edges);
+      s.measure("dfs", "dfs", in.name, 1, g.num_edges(), [&] { dfs(g); });
+    }
+
+  if (s.wanted("scc")) {
+    vector<input> inputs = {graphs[0], graphs[2],
+                            {"cycle" + sc, n, chain_edges(n, true)}};
+    for (auto &in : inputs) {
+      csr_graph g(in.n, in.edges);
+      auto gt = transpose(g);
+      double m = g.num_edges();
+      s.measure("scc", "tarjan_scc", in.name, 1, m, [&] { tarjan_scc(g); });
+      s.scaling("scc", "parallel_scc", in.name, m,
+                [&](thread_pool &pool) { parallel_scc(g, gt, pool); });
+    }
+  }
+
+  if (s.wanted("toposort")) {
+    vector<input> inputs = {{"dag" + sc, n, random_dag_edges(n, 8LL * n, 3)},
+                            graphs[3]};
+    for (auto &in : inputs) {
+      csr_graph g(in.n, in.edges);
+      double m = g.num_edges();
+      s.measure("toposort", "topological_sort", in.name, 1, m,
+                [&] { topological_sort(g); });
+      s.measure("toposort", "dfs_topological_sort", in.name, 1, m,
+                [&] { dfs_topological_sort(g); });
+    }
+  }
+
+  if (s.wanted("sssp")) {
+    for (int i : {0, 2}) {
+      auto &in = graphs[i];
+      weighted_csr_graph<W> g(in.n,
+                              with_random_weights<W>(in.edges, 1, 1000, 4));
+      int src = max_degree_vertex(g);
+      double m = g.num_edges();
+      s.measure("sssp", "dijkstra", in.name, 1, m, [&] { dijkstra(g, src); });
+      s.measure("sssp", "dijkstra<radix_heap>", in.name, 1, m,
+                [&] { dijkstra<radix_heap<W>>(g, src); });
+      s.scaling("sssp", "delta_stepping", in.name, m, [&](thread_pool &pool) {
+        delta_stepping(g, src, W(100), pool);
+      });
+      s.measure("sssp", "bellman_ford", in.name, 1, m,
+                [&] { bellman_ford(g, src); });
+      s.scaling("sssp", "parallel_bellman_ford", in.name, m,
+                [&](thread_pool &pool) {
+                  parallel_bellman_ford(g, src, pool);
+                });
+    }
+    auto dag_edges = random_dag_edges(n, 8LL * n, 3);
+    weighted_csr_graph<W> dag(n,
+                              with_random_weights<W>(dag_edges, 1, 1000, 5));
+    s.measure("sssp", "dag_shortest_paths", "dag" + sc, 1, dag.num_edges(),
+              [&] { dag_shortest_paths(dag, 0); });
+  }
+
+  if (s.wanted("mst"))
+    for (int i : {0, 1}) {
+      auto &in = graphs[i];
+      auto edges = with_random_weights<W>(in.edges, 1, 1000000, 6);
+      auto g = undirected_graph(in.n, edges);
+      double m = edges.size();
+      s.measure("mst", "kruskal", in.name, 1, m,
+                [&] { kruskal(in.n, edges); });
+      s.measure("mst", "filter_kruskal", in.name, 1, m,
+                [&] { filter_kruskal(in.n, edges); });
+      s.measure("mst", "prim", in.name, 1, m, [&] { prim(g); });
+      s.scaling("mst", "boruvka", in.name, m,
+                [&](thread_pool &pool) { boruvka(in.n, edges, pool); });
+    }
+
+  if (s.wanted("heap")) {
+    size_t count = size_t(16) << o.scale;
+    mt19937_64 rng(7);
+    vector<W> keys(count);
+    for (auto &k : keys)
+      k = static_cast<W>(rng() >> 1);
+    string in = "random-" + to_string(o.scale + 4);
+    double ops = 2.0 * count;
+    s.measure("heap", "std::priority_queue", in, 1, ops, [&] {
+      priority_queue<W, vector<W>, greater<W>> q;
+      for (auto k : keys)
+        q.push(k);
+      while (!q.empty())
+        q.pop();
+    });
+    s.measure("heap", "binary_heap", in, 1, ops, [&] {
+      binary_heap<W> q;
+      for (auto k : keys)
+        q.push(k);
+      while (!q.empty())
+        q.pop();
+    });
+    s.measure("heap", "d_ary_heap<4>", in, 1, ops, [&] {
+      d_ary_heap<W, 4> q;
+      for (auto k : keys)
+        q.push(k);
+      while (!q.empty())
+        q.pop();
+    });
+    pairing_heap<W>::pool_type ppool;
+    s.measure("heap", "pairing_heap", in, 1, ops, [&] {
+      ppool.reset();
+      pairing_heap<W> q(ppool);
+      for (auto k : keys)
+        q.push(k, 0);
+      while (!q.empty())
+        q.extract_min();
+    });
+    fibonacci_heap<W>::pool_type fpool;
+    s.measure("heap", "fibonacci_heap", in, 1, ops, [&] {
+      fpool.reset();
+      fibonacci_heap<W> q(fpool);
+      for (auto k : keys)
+        q.push(k, 0);
+      while (!q.empty())
+        q.extract_min();
+    });
+  }
+
+  if (s.wanted("maxsub")) {
+    size_t count = size_t(256) << o.scale;
+    mt19937 rng(8);
+    vector<int> v(count);
+    for (auto &x : v)
+      x = static_cast<int>(rng() % 2001) - 1000;
+    string in = "random-" + to_string(o.scale + 8);
+    auto b = v.begin(), e = v.end();
+    s.measure("maxsub", "find_max_subarray", in, 1, count,
+              [&] { sink = find_max_subarray(b, e).high; });
+    s.measure("maxsub", "kadane", in, 1, count,
+              [&] { sink = kadane(b, e).high; });
+    s.measure("maxsub", "blocked_max_subarray", in, 1, count,
+              [&] { sink = blocked_max_subarray(b, e).high; });
+    s.scaling("maxsub", "parallel_max_subarray", in, count,
+              [&](thread_pool &pool) {
+                sink = parallel_max_subarray(b, e, pool).high;
+              });
+  }
+
+  if (!o.csv.empty()) {
+    ofstream out(o.csv);
+    s.log.write_csv(out);
+  }
+  if (!o.json.empty()) {
+    ofstream out(o.json);
+    s.log.write_json(out);
+  }
+}
@@ -0,0 +1,66 @@
+// maximum subarray kernels benchmark, see max-subarray.hpp
+//
+// g++ max-subarray-bench.cpp -std=c++14 -O2 -pthread
+// ./a.out [max elements=2^26] [max threads=hardware threads]
+//
+// The input is a random walk of int price changes in [-1000, 1000] and the
+// same as double, throughput in millions of elements per second.
+
+#include "../util/bench.hpp"
+#include "../util/parallel.hpp"
+#include "max-subarray.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::divide_and_conquer;
+using namespace clrs::util;
+
+template <class T>
+void run(const char *type, const vector<T> &v, int max_threads) {
+  auto b = v.begin(), e = v.end();
+  int repeat = v.size() < (1 << 22) ? 10 : 3;
+  subarray<typename sum_type<void, decltype(b)>::type> expected, r;
+  auto report = [&](const string &kernel, double t) {
+    // the floating point sums may round differently
+    assert(r.sum == expected.sum || !is_integral<T>::value);
+    printf("%-8s %12zu %-26s %10.1f\n", type, v.size(), kernel.c_str(),
+           v.size() / t / 1e6);
+  };
+  double t = best_time(repeat, [&] { expected = kadane(b, e); });
+  r = expected;
+  report("kadane", t);
+  t = best_time(repeat, [&] { r = blocked_max_subarray(b, e); });
+  report("blocked prefix sums", t);
+  if (v.size() <= (1 << 22)) {
+    t = best_time(repeat, [&] { r = find_max_subarray(b, e); });
+    report("divide-and-conquer", t);
+  }
+  for (int threads = 1;; threads = min(2 * threads, max_threads)) {
+    thread_pool pool(threads);
+    t = best_time(repeat, [&] { r = parallel_max_subarray(b, e, pool); });
+    report("parallel x" + to_string(threads), t);
+    if (threads == max_threads)
+      break;
+  }
+}
+
+int main(int argc, char **argv) {
+  size_t max_n = argc > 1 ? atoll(argv[1]) : size_t(1) << 26;
+  int max_threads = argc > 2 ? atoi(argv[2]) : hardware_threads();
+  printf("%-8s %12s %-26s %10s\n", "type", "elements", "kernel",
+         "Melems/s");
+  mt19937 rng(1);
+  for (size_t n = 1 << 14; n <= max_n; n <<= 4) {
+    vector<int> v(n);
+    for (auto &x : v)
+      x = static_cast<int>(rng() % 2001) - 1000;
+    run("int", v, max_threads);
+    run("double", vector<double>(v.begin(), v.end()), max_threads);
+  }
+}
@@ -0,0 +1,105 @@
+// range max subarray queries on a changing series, see
+// max-subarray-index.hpp
+//
+// g++ max-subarray-index.cpp -std=c++14 -O2 -pthread
+
+#include "../util/bench.hpp"
+#include "../util/parallel.hpp"
+#include "max-subarray-index.hpp"
+#include "max-subarray.hpp"
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace clrs::divide_and_conquer;
+using namespace clrs::util;
+
+// kadane on v[i..j], in the indices of v
+subarray<long long> expected(const vector<int> &v, size_t i, size_t j) {
+  auto r = kadane(v.begin() + i, v.begin() + j + 1);
+  r.low += i;
+  r.high += i;
+  return r;
+}
+
+bool same(const subarray<long long> &a, const subarray<long long> &b) {
+  return a.low == b.low && a.high == b.high && a.sum == b.sum;
+}
+
+int main() {
+
+  // CLRS P.68 Figure 4.1
+  vector<int> price_changes = {13, -3, -25, 20, 3,   -3, -16, -23, 18,
+                               20, -7, 12,  -5, -22, 15, -4,  7};
+  max_subarray_index<int> index(price_changes.begin(), price_changes.end());
+  auto r = index.query(0, price_changes.size() - 1);
+  assert(r.low == 8 && r.high == 11 && r.sum == 43);
+  // the first week only: buy before day 3, sell after day 4
+  r = index.query(0, 6);
+  assert(r.low == 3 && r.high == 4 && r.sum == 23);
+  // a correction on day 10 and a new tick
+  index.set(10, 7);
+  index.append(30);
+  r = index.query(0, index.size() - 1);
+  assert(r.low == 8 && r.high == 17 && r.sum == 78);
+
+  // random appends, corrections and queries, small values for many ties
+  mt19937 rng(3);
+  vector<int> v;
+  max_subarray_index<int> live;
+  for (int step = 0; step < 20000; ++step) {
+    int op = rng() % 4;
+    if (op == 0 || v.empty()) {
+      v.push_back(static_cast<int>(rng() % 7) - 3);
+      live.append(v.back());
+    } else if (op == 1) {
+      size_t i = rng() % v.size();
+      v[i] = static_cast<int>(rng() % 7) - 3;
+      live.set(i, v[i]);
+    } else {
+      size_t i = rng() % v.size(), j = rng() % v.size();
+      if (i > j)
+        swap(i, j);
+      assert(same(live.query(i, j), expected(v, i, j)));
+    }
+  }
+
+  // appends then flush: the const index answers from several threads
+  for (int k = 0; k < 100; ++k) {
+    v.push_back(static_cast<int>(rng() % 7) - 3);
+    live.append(v.back());
+  }
+  live.flush();
+  const auto &frozen = live;
+  thread_pool readers(4);
+  parallel_for(readers, 0, v.size(), [&](size_t lo, size_t hi, int) {
+    for (size_t i = lo; i < hi; i += 97)
+      assert(same(frozen.query(i, v.size() - 1),
+                  expected(v, i, v.size() - 1)));
+  });
+
+  // a batch of queries on a long series, against a scan per query
+  const size_t n = 1 << 20;
+  v.resize(n);
+  for (auto &x : v)
+    x = static_cast<int>(rng() % 2001) - 1000;
+  max_subarray_index<int> big(v.begin(), v.end());
+  vector<max_subarray_index<int>::range> queries(1 << 14);
+  for (auto &q : queries) {
+    q.first = rng() % n;
+    q.second = q.first + rng() % (n - q.first);
+  }
+  thread_pool pool(2);
+  vector<subarray<long long>> answers;
+  double indexed =
+      best_time(3, [&] { answers = big.query_batch(queries, &pool); });
+  stopwatch w;
+  for (size_t q = 0; q < 256; ++q)
+    assert(same(answers[q], expected(v, queries[q].first, queries[q].second)));
+  double scan = w.seconds() / 256 * queries.size();
+  printf("%zu queries on %zu elements: index %.4fs, kadane per query %.4fs "
+         "(estimated)\n",
+         queries.size(), n, indexed, scan);
+}
@@ -0,0 +1,185 @@
+// Data structure: Max Subarray Index (segment tree)
+
+// Representation: Array, a complete binary tree stored level by level: the
+// leaves are nodes cap..2cap-1 (cap a power of two >= n), the children of
+// node i are 2i and 2i+1.
+
+// Description: Answers "best buy/sell window between day i and day j" on a
+// series that keeps changing.  Each node keeps the chunk_summary (total,
+// best prefix, best suffix, best subarray, see max-subarray.hpp) of the
+// elements under it, computed from its two children by combine: the best
+// subarray of a node is the best of its children's or the crossing one
+// made of the suffix of the left child and the prefix of the right child,
+// the merge step of find_max_subarray.
+//  - query(i, j) combines the O(lgn) nodes covering i..j, left to right,
+//  - set(i, x) recomputes the lgn ancestors of leaf i,
+//  - append(x) only writes the leaf.  The ancestors of the new leaves are
+//    recomputed in one bottom-up sweep by flush(), which the next
+//    (non-const) query does first: k appends cost O(k + lgn) in all.  When
+//    the leaves run out, cap doubles and the tree is rebuilt in O(n), O(1)
+//    amortized per append.
+// A const index is only read: its queries can run side by side, once the
+// appends have been flushed.
+// The answers are the subarrays kadane would find on v[i..j], ties
+// included.
+
+// APIs
+// build : from a range of elements........................................O(n)
+// query : best subarray of v[i..j]......................................O(lgn)
+// query_batch : many queries, optionally on a thread pool.........O(q lgn / p)
+// set : v[i] = x........................................................O(lgn)
+// append : push x at the end.....................................O(1) amortized
+// flush : the ancestors of the appended leaves.............O(appends + lgn)
+// size/value..............................................................O(1)
+
+#pragma once
+
+#include "../util/parallel.hpp"
+#include "max-subarray.hpp"
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace clrs {
+namespace divide_and_conquer {
+
+template <class T, class Sum = sum_type_t<void, const T *>>
+class max_subarray_index {
+public:
+  using value_type = T;
+  using sum_type = Sum;
+  using range = std::pair<size_t, size_t>; // i..j, both inclusive
+
+  max_subarray_index() {}
+  template <class It> max_subarray_index(It first, It last) {
+    _v.assign(first, last);
+    rebuild();
+  }
+
+  size_t size() const { return _v.size(); }
+  const T &value(size_t i) const { return _v[i]; }
+
+  void set(size_t i, const T &x) {
+    assert(i < size());
+    _v[i] = x;
+    _node[_cap + i] = leaf(i);
+    if (i >= _built)
+      return; // its ancestors wait for the next flush anyway
+    for (size_t p = (_cap + i) / 2; p > 0; p /= 2)
+      pull(p);
+  }
+
+  void append(const T &x) {
+    _v.push_back(x);
+    if (_v.size() > _cap) {
+      rebuild();
+      return;
+    }
+    _node[_cap + _v.size() - 1] = leaf(_v.size() - 1);
+  }
+
+  // recomputes the ancestors of the leaves appended since the last flush,
+  // level by level, each node once
+  void flush() {
+    if (_built == _v.size())
+      return;
+    for (size_t lo = (_cap + _built) / 2, hi = (_cap + _v.size() - 1) / 2;
+         hi > 0; lo /= 2, hi /= 2)
+      for (size_t p = lo; p <= hi; ++p)
+        pull(p);
+    _built = _v.size();
+  }
+
+  // the tree is made up to date first
+  subarray<Sum> query(size_t i, size_t j) {
+    flush();
+    return static_cast<const max_subarray_index &>(*this).query(i, j);
+  }
+
+  // only reads the tree, the appends must have been flushed
+  subarray<Sum> query(size_t i, size_t j) const {
+    assert(i <= j && j < size());
+    assert(_built == _v.size());
+    // the nodes covering i..j from the left end and from the right end
+    node left, right;
+    for (size_t l = _cap + i, r = _cap + j + 1; l < r; l /= 2, r /= 2) {
+      if (l & 1)
+        left = merge(left, _node[l++]);
+      if (r & 1)
+        right = merge(_node[--r], right);
+    }
+    return merge(left, right).s.best;
+  }
+
+  // Flushes once, then the queries go through the const query: they only
+  // read the tree and run side by side on the pool.  Not const, since the
+  // flush writes the tree; the const query is the one that's safe from
+  // several threads at once.
+  std::vector<subarray<Sum>> query_batch(const std::vector<range> &queries,
+                                         util::thread_pool *pool = nullptr) {
+    flush();
+    const max_subarray_index &index = *this;
+    std::vector<subarray<Sum>> r(queries.size());
+    auto answer = [&](size_t lo, size_t hi, int) {
+      for (auto q = lo; q < hi; ++q)
+        r[q] = index.query(queries[q].first, queries[q].second);
+    };
+    if (pool && queries.size() >= 256)
+      util::parallel_for(*pool, 0, queries.size(), answer);
+    else
+      answer(0, queries.size(), 0);
+    return r;
+  }
+
+private:
+  // the summary of no element at all, for the leaves past the end
+  struct node {
+    bool empty = true;
+    chunk_summary<Sum> s;
+  };
+
+  static node merge(const node &a, const node &b) {
+    if (a.empty)
+      return b;
+    if (b.empty)
+      return a;
+    node r;
+    r.empty = false;
+    r.s = combine(a.s, b.s);
+    return r;
+  }
+
+  node leaf(size_t i) const {
+    Sum x = static_cast<Sum>(_v[i]);
+    subarray<Sum> one{i, i, x};
+    node r;
+    r.empty = false;
+    r.s = chunk_summary<Sum>{x, one, one, one};
+    return r;
+  }
+
+  void pull(size_t p) {
+    _node[p] = merge(_node[2 * p], _node[2 * p + 1]);
+  }
+
+  void rebuild() {
+    _cap = 1;
+    while (_cap < _v.size())
+      _cap *= 2;
+    _node.assign(2 * _cap, node());
+    for (size_t i = 0; i < _v.size(); ++i)
+      _node[_cap + i] = leaf(i);
+    for (size_t p = _cap; p-- > 1;)
+      pull(p);
+    _built = _v.size();
+  }
+
+  std::vector<T> _v;
+  size_t _cap = 0;
+  std::vector<node> _node;
+  size_t _built = 0; // the leaves 0.._built-1 have their ancestors
+};
+}
+}
@@ -44,75 +44,40 @@
 // Concretely, we need a find_max_crossing_subarray procedure to deal with
 // the crossing subarray case and find_max_subarray to deal the rest.
 //
-// We'll first use int indexed vector to represent the array and
-// do a vanilla implementation that is fidel to the pseudo-code in CLRS.
-// Later we can modify the procedures to support iterators and use std c++
-// algorithms as an exercise.
+// We first did a vanilla implementation on an int indexed vector<int> that
+// is fidel to the pseudo-code in CLRS.  It now lives in max-subarray.hpp,
+// on any random access iterator and with a wider type for the sums, next to
+// the linear time kernels we use on long series.
 //
-// g++ max-subarray.cpp -std=c++14
+// g++ max-subarray.cpp -std=c++14 -pthread
+#include "max-subarray.hpp"
+#include <algorithm>
 #include <cassert>
+#include <climits>
 #include <iostream>
-#include <limits>
-#include <tuple>
+#include <random>
 #include <vector>
 
 using namespace std;
+using namespace clrs::divide_and_conquer;
 
-decltype(auto) find_max_crossing_subarray(const vector<int> &v, int low,
-                                          int mid, int high) {
+template <class S> bool same(const subarray<S> &a, const subarray<S> &b) {
+  return a.low == b.low && a.high == b.high && a.sum == b.sum;
+}
 
-  int left_sum = numeric_limits<int>::min();
-  // from midpoint and extend to the left as much as possible
-  // to maximize the left sum
-  int sum = 0;       // records the running sum
-  int leftest = mid; // records the leftest point
-  for (auto i = mid; i >= low; --i) {
-    sum += v[i]; // accumulate the sum (accumulate you say? that reminds me of
-                 // something...)
-    if (sum > left_sum) {
-      left_sum = sum;
-      leftest = i;
-    }
-    // ATTENTION: don't break prematurelly, the running sum can go up and down
-    // we must go through the whole left half to find out the max point.
-  }
-  // Now do the right half,
-  int right_sum = numeric_limits<int>::min();
-  sum = 0;
-  int rightest = mid;
-  // Aha, you're doing copy-paste! (probably an opportunity
-  // for refactoring, look at the beautiful symmetry)
-  for (auto i = mid + 1; i <= high; ++i) {
-    sum += v[i]; // accumulate the sum (accumulate you say? that reminds me of
-                 // something...)
-    if (sum > right_sum) {
-      right_sum = sum;
-      rightest = i;
+// all the subarrays, the best by the tie-break of max-subarray.hpp
+subarray<long long> brute_force(const vector<int> &v) {
+  subarray<long long> best{0, 0, v[0]};
+  for (size_t i = 0; i < v.size(); ++i) {
+    long long sum = 0;
+    for (size_t j = i; j < v.size(); ++j) {
+      sum += v[j];
+      subarray<long long> s{i, j, sum};
+      if (better(s, best))
+        best = s;
     }
-    // ATTENTION: don't break prematurelly, the running sum can go up and down
-    // we must go through the whole left half to find out the max point.
   }
-
-  // now I have the max crossing subarray
-  return make_tuple(leftest, rightest, left_sum + right_sum);
-}
-
-decltype(auto) find_max_subarray(const vector<int> &v, int low, int high) {
-  // the base case (recursion end point)
-  if (low == high)
-    return make_tuple(low, high, v[low]);
-  int mid = (low + high) / 2;
-  auto left_max_subarray = find_max_subarray(v, low, mid);
-  auto right_max_subarray = find_max_subarray(v, mid + 1, high);
-  auto max_crossing_subarray = find_max_crossing_subarray(v, low, mid, high);
-  // make a 3-way comparison to determine the true max subarray
-  auto max_subarray = (get<2>(left_max_subarray) > get<2>(right_max_subarray))
-                          ? left_max_subarray
-                          : right_max_subarray;
-  max_subarray = (get<2>(max_subarray) > get<2>(max_crossing_subarray))
-                     ? max_subarray
-                     : max_crossing_subarray;
-  return max_subarray;
+  return best;
 }
 
 int main() {
@@ -126,10 +91,47 @@ int main() {
   // change 18)
   // sell all after day 11 (price change 12)
   auto max_subarray =
-      find_max_subarray(price_changes, 0, price_changes.size() - 1);
-  cout << get<0>(max_subarray) << "," << get<1>(max_subarray) << ","
-       << get<2>(max_subarray) << "\n";
-  assert(get<0>(max_subarray) == 8);
-  assert(get<1>(max_subarray) == 11);
-  assert(get<2>(max_subarray) == 43);
+      find_max_subarray(price_changes.begin(), price_changes.end());
+  cout << max_subarray.low << "," << max_subarray.high << ","
+       << max_subarray.sum << "\n";
+  assert(max_subarray.low == 8);
+  assert(max_subarray.high == 11);
+  assert(max_subarray.sum == 43);
+  auto b = price_changes.begin(), e = price_changes.end();
+  assert(same(kadane(b, e), max_subarray));
+  assert(same(blocked_max_subarray(b, e), max_subarray));
+  assert(same(parallel_max_subarray(b, e, 2), max_subarray));
+
+  // small values for many ties, every length around the block size
+  mt19937 rng(1);
+  clrs::util::thread_pool pool(3);
+  for (int round = 0; round < 300; ++round) {
+    vector<int> v(1 + rng() % (round < 200 ? 40 : 5000));
+    for (auto &x : v)
+      x = static_cast<int>(rng() % 5) - 2;
+    auto d = find_max_subarray(v.begin(), v.end());
+    if (v.size() <= 40)
+      assert(same(d, brute_force(v)));
+    assert(same(kadane(v.begin(), v.end()), d));
+    assert(same(blocked_max_subarray(v.begin(), v.end()), d));
+    assert(same(parallel_max_subarray(v.begin(), v.end(), pool), d));
+  }
+
+  // all negative: the largest element alone, the first of them
+  vector<int> negative = {-5, -2, -7, -2, -9};
+  auto n = kadane(negative.begin(), negative.end());
+  assert(n.low == 1 && n.high == 1 && n.sum == -2);
+  assert(same(find_max_subarray(negative.begin(), negative.end()), n));
+
+  // an int sum would overflow, the chunks of the parallel kernel cut the
+  // best subarray
+  vector<int> big(1 << 20, INT_MAX / 2);
+  fill(big.begin(), big.begin() + 101, INT_MIN);
+  auto r = parallel_max_subarray(big.begin(), big.end(), pool);
+  assert(r.low == 101 && r.high == big.size() - 1);
+  assert(r.sum == (long long)(INT_MAX / 2) * (long long)(big.size() - 101));
+  assert(same(kadane(big.begin(), big.end()), r));
+  assert(same(blocked_max_subarray(big.begin(), big.end()), r));
+  assert(same(find_max_subarray(big.begin(), big.end()), r));
+  cout << "sum of " << r.high - r.low + 1 << " elements: " << r.sum << "\n";
 }
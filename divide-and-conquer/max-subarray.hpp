@@ -0,0 +1,312 @@
+// maximum subarray kernels (CLRS 4.1)
+//
+// max-subarray.cpp tells the story of the divide-and-conquer algorithm,
+// find_max_subarray below is that algorithm.  It's O(nlgn), for long series
+// (tick data, billions of price changes) we run one of the linear kernels:
+//
+// kadane: one pass.  The best subarray ending at i is either v[i] alone or
+//   the best one ending at i-1 extended by v[i], whichever is bigger (CLRS
+//   exercise 4.1-5).
+//
+// blocked_max_subarray: the same thing seen through prefix sums,
+//   P[0] = 0, P[j+1] = v[0] + ... + v[j], the sum of v[i..j] is
+//   P[j+1] - P[i] so the best subarray ending at j starts after the
+//   minimum of P[0..j].  The array is processed in blocks: a scan writes
+//   the prefix sums and their running minimum into two small buffers, then
+//   the differences are max-reduced in a loop without any branch or loop
+//   carried dependency, which the compiler vectorizes.  Only a block that
+//   beats the best so far is looked at again to find where.  The scan still
+//   carries a dependency as long as kadane's, so on one core kadane usually
+//   wins (see max-subarray-bench.cpp); the buffers are where a hand
+//   vectorized scan would plug in.
+//
+// parallel_max_subarray: the array is cut into chunks, each chunk is
+//   summarized by one pass into
+//     total   its sum,
+//     prefix  the best subarray starting at its first element,
+//     suffix  the best subarray ending at its last element,
+//     best    its best subarray,
+//   and the summaries of neighbouring chunks combine into the summary of
+//   their concatenation (the best subarray of the concatenation is the
+//   best of either side, or the suffix of the left one followed by the
+//   prefix of the right one: the crossing subarray of the
+//   divide-and-conquer again).  The combine is associative so the chunks
+//   are summarized in parallel and reduced left to right.
+//
+// The sums are accumulated in Sum, by default long long for integer
+// elements (int price changes overflow an int sum quickly) and the element
+// type itself for floating point ones.
+//
+// Several subarrays can have the maximum sum, all the kernels return the
+// same one: the one with the smallest low, then the smallest high.  With a
+// floating point Sum the kernels add up in different orders, so they may
+// round differently.
+#pragma once
+
+#include "../util/parallel.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace clrs {
+namespace divide_and_conquer {
+
+using std::size_t;
+
+// v[low..high], both inclusive, and its sum
+template <class Sum> struct subarray {
+  size_t low;
+  size_t high;
+  Sum sum;
+};
+
+// the larger sum wins, then the leftmost then shortest subarray
+template <class Sum>
+bool better(const subarray<Sum> &a, const subarray<Sum> &b) {
+  if (a.sum != b.sum)
+    return a.sum > b.sum;
+  return a.low != b.low ? a.low < b.low : a.high < b.high;
+}
+
+// Sum = void picks the default accumulator for the element type
+template <class Sum, class It> struct sum_type {
+  using element = typename std::iterator_traits<It>::value_type;
+  using type = typename std::conditional<
+      !std::is_void<Sum>::value, Sum,
+      typename std::conditional<std::is_integral<element>::value, long long,
+                                element>::type>::type;
+};
+template <class Sum, class It>
+using sum_type_t = typename sum_type<Sum, It>::type;
+
+template <class Sum = void, class It>
+subarray<sum_type_t<Sum, It>> find_max_crossing_subarray(It v, size_t low,
+                                                         size_t mid,
+                                                         size_t high) {
+  using S = sum_type_t<Sum, It>;
+  // from midpoint and extend to the left as much as possible
+  // to maximize the left sum
+  S sum = v[mid];       // records the running sum
+  S left_sum = sum;     // v[mid] alone to start with
+  size_t leftest = mid; // records the leftest point
+  for (auto i = mid; i-- > low;) {
+    sum += v[i]; // accumulate the sum (accumulate you say? that reminds me of
+                 // something...)
+    // >= : on a tie the leftest point wins
+    if (sum >= left_sum) {
+      left_sum = sum;
+      leftest = i;
+    }
+    // ATTENTION: don't break prematurelly, the running sum can go up and down
+    // we must go through the whole left half to find out the max point.
+  }
+  // Now do the right half,
+  sum = v[mid + 1];
+  S right_sum = sum;
+  size_t rightest = mid + 1;
+  // Aha, you're doing copy-paste! (probably an opportunity
+  // for refactoring, look at the beautiful symmetry)
+  for (auto i = mid + 2; i <= high; ++i) {
+    sum += v[i];
+    // > : on a tie the shortest wins
+    if (sum > right_sum) {
+      right_sum = sum;
+      rightest = i;
+    }
+  }
+
+  // now I have the max crossing subarray
+  return subarray<S>{leftest, rightest, left_sum + right_sum};
+}
+
+template <class Sum = void, class It>
+subarray<sum_type_t<Sum, It>> find_max_subarray(It v, size_t low,
+                                                size_t high) {
+  using S = sum_type_t<Sum, It>;
+  // the base case (recursion end point)
+  if (low == high)
+    return subarray<S>{low, high, static_cast<S>(v[low])};
+  size_t mid = low + (high - low) / 2;
+  auto left_max_subarray = find_max_subarray<S>(v, low, mid);
+  auto right_max_subarray = find_max_subarray<S>(v, mid + 1, high);
+  auto max_crossing_subarray = find_max_crossing_subarray<S>(v, low, mid, high);
+  // make a 3-way comparison to determine the true max subarray
+  auto max_subarray = better(right_max_subarray, left_max_subarray)
+                          ? right_max_subarray
+                          : left_max_subarray;
+  return better(max_crossing_subarray, max_subarray) ? max_crossing_subarray
+                                                     : max_subarray;
+}
+
+// [first, last) must not be empty
+template <class Sum = void, class It>
+subarray<sum_type_t<Sum, It>> find_max_subarray(It first, It last) {
+  assert(first != last);
+  return find_max_subarray<Sum>(first, 0, std::distance(first, last) - 1);
+}
+
+template <class Sum = void, class It>
+subarray<sum_type_t<Sum, It>> kadane(It first, It last) {
+  using S = sum_type_t<Sum, It>;
+  assert(first != last);
+  subarray<S> best{0, 0, static_cast<S>(*first)};
+  S sum = best.sum; // the best sum ending at i, starting at low
+  size_t low = 0, n = std::distance(first, last);
+  for (size_t i = 1; i < n; ++i) {
+    S x = static_cast<S>(first[i]);
+    // extending by a zero sum keeps the sum and moves low to the left
+    if (sum >= 0) {
+      sum += x;
+    } else {
+      sum = x;
+      low = i;
+    }
+    if (sum > best.sum)
+      best = subarray<S>{low, i, sum};
+  }
+  return best;
+}
+
+template <class Sum = void, class It, size_t Block = 2048>
+subarray<sum_type_t<Sum, It>> blocked_max_subarray(It first, It last) {
+  using S = sum_type_t<Sum, It>;
+  assert(first != last);
+  size_t n = std::distance(first, last);
+  S prefix[Block], low_prefix[Block];
+  S p = 0;           // P[b], b the first index of the block
+  S min_p = 0;       // min of P[0..b]
+  size_t min_at = 0; // its first position
+  subarray<S> best{0, 0, static_cast<S>(*first)};
+  for (size_t b = 0; b < n; b += Block) {
+    size_t len = std::min(Block, n - b);
+    // prefix[k] = P[b+k+1], low_prefix[k] = min of P[0..b+k]
+    S m = min_p;
+    for (size_t k = 0; k < len; ++k) {
+      low_prefix[k] = m;
+      p += static_cast<S>(first[b + k]);
+      prefix[k] = p;
+      m = p < m ? p : m;
+    }
+    S block_best = prefix[0] - low_prefix[0];
+    for (size_t k = 1; k < len; ++k) {
+      S d = prefix[k] - low_prefix[k];
+      block_best = d > block_best ? d : block_best;
+    }
+    if (b == 0 || block_best > best.sum) {
+      // the first j reaching it, then the first minimum before j
+      size_t k = 0;
+      while (prefix[k] - low_prefix[k] != block_best)
+        ++k;
+      size_t low = min_at;
+      if (low_prefix[k] != min_p) {
+        low = b + 1;
+        while (prefix[low - b - 1] != low_prefix[k])
+          ++low;
+      }
+      best = subarray<S>{low, b + k, block_best};
+    }
+    // the minimum of the block's prefixes for the next blocks
+    if (m < min_p) {
+      size_t k = 0;
+      while (prefix[k] != m)
+        ++k;
+      min_p = m;
+      min_at = b + k + 1;
+    }
+  }
+  return best;
+}
+
+// what the parallel kernel computes for each chunk
+template <class Sum> struct chunk_summary {
+  Sum total;
+  subarray<Sum> prefix, suffix, best;
+};
+
+template <class Sum = void, class It>
+chunk_summary<sum_type_t<Sum, It>> summarize(It v, size_t first,
+                                             size_t last) {
+  using S = sum_type_t<Sum, It>;
+  assert(first < last);
+  // the prefix sums again, relative to the chunk, all in one pass
+  S p = 0, max_p = 0, min_p = 0;
+  size_t max_at = first, min_at = first;
+  subarray<S> best{first, first, 0};
+  for (size_t i = first; i < last; ++i) {
+    p += static_cast<S>(v[i]);
+    // the best ending at i starts at the first minimum before
+    S d = p - min_p;
+    if (i == first || d > best.sum)
+      best = subarray<S>{min_at, i, d};
+    // the prefix ending at i, the first maximum
+    if (i == first || p > max_p) {
+      max_p = p;
+      max_at = i;
+    }
+    // the suffix starting at i+1 is total - p, the first minimum of p
+    if (i + 1 < last && p < min_p) {
+      min_p = p;
+      min_at = i + 1;
+    }
+  }
+  return chunk_summary<S>{p,
+                          subarray<S>{first, max_at, max_p},
+                          subarray<S>{min_at, last - 1, p - min_p},
+                          best};
+}
+
+// the summary of a followed by b
+template <class Sum>
+chunk_summary<Sum> combine(const chunk_summary<Sum> &a,
+                           const chunk_summary<Sum> &b) {
+  chunk_summary<Sum> r;
+  r.total = a.total + b.total;
+  // ties: the shortest prefix, the longest suffix
+  Sum through = a.total + b.prefix.sum;
+  r.prefix = a.prefix.sum >= through
+                 ? a.prefix
+                 : subarray<Sum>{a.prefix.low, b.prefix.high, through};
+  through = a.suffix.sum + b.total;
+  r.suffix = through >= b.suffix.sum
+                 ? subarray<Sum>{a.suffix.low, b.suffix.high, through}
+                 : b.suffix;
+  subarray<Sum> crossing{a.suffix.low, b.prefix.high,
+                         a.suffix.sum + b.prefix.sum};
+  r.best = better(b.best, a.best) ? b.best : a.best;
+  if (better(crossing, r.best))
+    r.best = crossing;
+  return r;
+}
+
+template <class Sum = void, class It>
+subarray<sum_type_t<Sum, It>> parallel_max_subarray(It first, It last,
+                                                    util::thread_pool &pool) {
+  using S = sum_type_t<Sum, It>;
+  assert(first != last);
+  size_t n = std::distance(first, last);
+  // a few chunks per thread, at least 64k elements each
+  size_t chunks = std::max<size_t>(
+      1, std::min<size_t>(4 * pool.size(), n / (size_t(1) << 16)));
+  std::vector<chunk_summary<S>> summary(chunks);
+  util::parallel_for_dynamic(pool, 0, chunks, 1, [&](size_t lo, size_t hi,
+                                                     int) {
+    for (auto c = lo; c < hi; ++c)
+      summary[c] = summarize<S>(first, n * c / chunks, n * (c + 1) / chunks);
+  });
+  auto r = summary[0];
+  for (size_t c = 1; c < chunks; ++c)
+    r = combine(r, summary[c]);
+  return r.best;
+}
+
+template <class Sum = void, class It>
+subarray<sum_type_t<Sum, It>> parallel_max_subarray(It first, It last,
+                                                    int threads) {
+  util::thread_pool pool(threads);
+  return parallel_max_subarray<Sum>(first, last, pool);
+}
+}
+}
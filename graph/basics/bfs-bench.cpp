@@ -0,0 +1,79 @@
+// bfs benchmark: sequential bfs against parallel_bfs on 1..N threads
+//
+// g++ bfs-bench.cpp -std=c++14 -O2 -pthread
+// ./a.out [scale=18] [max threads=hardware threads]
+//
+// The input is an undirected R-MAT graph with 2^scale vertices and
+// 16 * 2^scale edges (each way).  The bfs starts from the vertex of highest
+// degree, the traversed edges per second (TEPS) counts the edges it scans.
+
+#include "../../util/bench.hpp"
+#include "../../util/parallel.hpp"
+#include "bfs.hpp"
+#include "csr.hpp"
+#include "generators.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+int main(int argc, char **argv) {
+  int scale = argc > 1 ? atoi(argv[1]) : 18;
+  int max_threads = argc > 2 ? atoi(argv[2]) : hardware_threads();
+
+  csr_graph g(1 << scale, symmetrize(rmat_edges(scale, 16, 1)));
+  int source = 0;
+  for (int v = 0; v < g.num_vertices(); ++v)
+    if (g.degree(v) > g.degree(source))
+      source = v;
+  auto expected = bfs(g, source);
+  size_t scanned = 0;
+  for (int v = 0; v < g.num_vertices(); ++v)
+    if (expected.reached(v))
+      scanned += g.degree(v);
+
+  double base = best_time(3, [&] { bfs(g, source); });
+  printf("vertices: %d, edges: %zu\n", g.num_vertices(), g.num_edges());
+  printf("%-10s %8s %12s %8s\n", "threads", "seconds", "MTEPS", "speedup");
+  printf("%-10s %8.4f %12.2f %8.2f\n", "seq", base, scanned / base / 1e6, 1.0);
+  vector<int> counts;
+  for (int threads = 1; threads < max_threads; threads *= 2)
+    counts.push_back(threads);
+  counts.push_back(max_threads);
+  for (int threads : counts) {
+    thread_pool pool(threads);
+    bfs_result r;
+    double t = best_time(3, [&] { r = parallel_bfs(g, source, pool); });
+    assert(r.dist == expected.dist);
+    printf("%-10d %8.4f %12.2f %8.2f\n", threads, t, scanned / t / 1e6,
+           base / t);
+  }
+
+  // all-sources workload: bfs() once per source against multi_source_bfs
+  // 64 sources at a time, both summing up the distances (closeness)
+  const int sources = 256;
+  long long total = 0, ms_total = 0;
+  double one_by_one = best_time(1, [&] {
+    total = 0;
+    for (int s = 0; s < sources; ++s)
+      for (int d : bfs(g, s).dist)
+        total += d > 0 ? d : 0;
+  });
+  vector<int> batch;
+  double batched = best_time(1, [&] {
+    ms_total = 0;
+    for (int first = 0; first < sources; first += ms_bfs_width) {
+      batch.clear();
+      for (int s = first; s < first + ms_bfs_width; ++s)
+        batch.push_back(s);
+      multi_source_bfs(g, batch, [&](int, int, int d) { ms_total += d; });
+    }
+  });
+  assert(total == ms_total);
+  printf("%d sources: bfs each %.4fs, multi-source %.4fs (%.2fx)\n", sources,
+         one_by_one, batched, one_by_one / batched);
+}
@@ -1,55 +1,18 @@
 // implement a breath-first-search algorithm
+//
+// g++ bfs.cpp -std=c++14 -pthread
 
+#include "bfs.hpp"
+#include "csr.hpp"
 #include "graph.hpp"
 #include <cassert>
-#include <deque>
+#include <algorithm>
 #include <iostream>
-#include <set>
+#include <random>
 #include <vector>
 
 using namespace std;
 using namespace clrs::graph;
-// some utility free functions
-template <class T, int V> void print_path(fixed_graph<T, V> &g, int s, int v) {
-  if (s == v)
-    cout << s + 1 << ",";
-  else if (!g.graph[v].head.prev)
-    cout << "no path between " << s + 1 << " and " << v + 1;
-  else {
-    print_path(g, s, g.graph[v].head.prev->id);
-    cout << v + 1 << ",";
-  }
-}
-
-template <class T, int V> void print(fixed_graph<T, V> &g, int s, int v) {
-
-  cout << "path between " << s + 1 << " and " << v + 1 << ": ";
-  print_path(g, s, v);
-  cout << "\n";
-}
-
-template <class T, int V> void bfs(fixed_graph<T, V> &g, int s) {
-  assert(s < V);
-  vector<bool> visited(V, false);
-  deque<int> fifo;
-  fifo.push_back(s);
-  while (!fifo.empty()) {
-    auto u = fifo.front();
-    for (auto it = g.graph[u].adj_list.begin(); it != g.graph[u].adj_list.end();
-         ++it) {
-      if (visited[it->id])
-        continue;
-      it->dist = g.graph[u].head.dist + 1;
-      it->prev = &g.graph[u].head;
-      g.graph[it->id].head.dist = it->dist;
-      g.graph[it->id].head.prev = it->prev;
-      set_visited(visited, it->id);
-      fifo.push_back(it->id);
-    }
-    fifo.pop_front();
-    set_visited(visited, u);
-  }
-}
 
 int main() {
 
@@ -68,9 +31,82 @@ int main() {
   g.add(node(3), node(2));
   g.add(node(3), node(1));
   g.add(node(3), node(4));
+  // every source gets its own result, the graph itself is never written
+  vector<bfs_result> results;
+  for (int i = 0; i < 5; ++i)
+    results.push_back(bfs(g, i));
   for (int i = 0; i < 5; ++i) {
-    bfs(g, i);
     for (int j = 0; j < 5; ++j)
-      print(g, i, j);
+      print(results[i], i, j);
+  }
+
+  // all the sources at once, one adjacency scan serves the 5 searches
+  vector<int> eccentricity(5, 0);
+  all_sources_bfs(g, [&](int s, int v, int d) {
+    assert(results[s].dist[v] == d);
+    eccentricity[s] = max(eccentricity[s], d);
+  });
+  for (int i = 0; i < 5; ++i)
+    cout << "eccentricity of " << i + 1 << ": " << eccentricity[i] << "\n";
+
+  // the same graph in CSR form must give the same distances
+  vector<edge> edges = {{0, 1}, {0, 4}, {4, 0}, {4, 1}, {4, 3}, {1, 0}, {1, 3},
+                        {1, 4}, {1, 2}, {2, 1}, {2, 3}, {3, 2}, {3, 1}, {3, 4}};
+  csr_graph cg(5, edges);
+  for (int i = 0; i < 5; ++i) {
+    auto r = bfs(cg, i);
+    assert(r.dist == results[i].dist);
+    assert(r.parent == results[i].parent);
+  }
+
+  // direction-optimizing bfs on a skewed random graph, the few low ids get
+  // most of the edges so the middle levels are huge
+  const int n = 1 << 14;
+  mt19937 rng(42);
+  vector<edge> random_edges;
+  for (int i = 0; i < 16 * n; ++i) {
+    int u = rng() % (rng() % n + 1), v = rng() % n;
+    random_edges.emplace_back(u, v);
+    random_edges.emplace_back(v, u);
+  }
+  csr_graph rg(n, random_edges);
+  auto rgt = transpose(rg);
+  auto expected = bfs(rg, 0);
+  bfs_counters counters;
+  auto r = direction_optimizing_bfs(rg, rgt, 0, &counters);
+  assert(r.dist == expected.dist);
+  for (int v = 0; v < n; ++v) {
+    if (r.parent[v] >= 0)
+      assert(r.dist[r.parent[v]] + 1 == r.dist[v]);
+  }
+  // the frontier of each level, they add up to the vertices reached
+  counting_observer levels;
+  bfs(rg, 0, levels);
+  assert(levels.frontier_sizes.size() ==
+         size_t(*max_element(expected.dist.begin(), expected.dist.end()) + 1));
+  size_t reached = 0;
+  for (auto size : levels.frontier_sizes)
+    reached += size;
+  assert(reached == levels.discovered && levels.frontier_sizes[0] == 1);
+
+  vector<int> sources;
+  for (int i = 0; i < 100; ++i)
+    sources.push_back(rng() % n);
+  auto matrix = distance_matrix(rg, sources);
+  for (size_t i = 0; i < sources.size(); ++i)
+    assert(matrix[i] == bfs(rg, sources[i]).dist);
+
+  // and the parallel one, whatever the number of threads
+  for (int threads = 1; threads <= 4; ++threads) {
+    auto pr = parallel_bfs(rg, 0, threads);
+    assert(pr.dist == expected.dist);
+    for (int v = 1; v < n; ++v) {
+      if (pr.parent[v] >= 0)
+        assert(pr.dist[pr.parent[v]] + 1 == pr.dist[v]);
+    }
   }
+  cout << "top-down: " << counters.top_down_levels << " levels, "
+       << counters.top_down_edges << " edges; bottom-up: "
+       << counters.bottom_up_levels << " levels, " << counters.bottom_up_edges
+       << " edges; plain bfs: " << rg.num_edges() << " edges\n";
 }
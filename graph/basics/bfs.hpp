@@ -0,0 +1,398 @@
+// breadth-first-search (CLRS 22.2)
+//
+// The traversal state lives in a bfs_result returned by bfs(), not in the
+// graph: dist[v] and parent[v] are dense arrays indexed by vertex id.  This
+// way the graph is only ever read, the same graph can be traversed from
+// several sources at once (even from several threads) and a run doesn't
+// clobber the results of the previous one.
+#pragma once
+
+#include "../../util/parallel.hpp"
+#include "bitmap.hpp"
+#include "graph.hpp"
+#include "observer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::deque;
+using std::size_t;
+using std::uint64_t;
+using std::vector;
+
+class bfs_result {
+public:
+  bfs_result() {}
+  bfs_result(int n, int source) : source(source), dist(n, -1), parent(n, -1) {}
+  bool reached(int v) const { return dist[v] >= 0; }
+
+  int source = -1;
+  vector<int> dist;   // -1 if v is not reachable from source
+  vector<int> parent; // -1 for the source and the unreachable vertices
+};
+
+// Works on anything providing num_vertices()/neighbours() (see graph.hpp).
+// obs sees the vertices enqueued (discover_vertex), the edges and the
+// levels, see observer.hpp.
+template <class G, class Observer>
+bfs_result bfs(const G &g, int s, Observer &obs) {
+  int n = num_vertices(g);
+  assert(s < n);
+  bfs_result r(n, s);
+  // dist doubles as the visited set, a vertex is visited once it has a
+  // distance
+  deque<int> fifo;
+  r.dist[s] = 0;
+  fifo.push_back(s);
+  obs.discover_vertex(s);
+  int level = -1;
+  while (!fifo.empty()) {
+    auto u = fifo.front();
+    // the first vertex of a level comes out when the queue holds exactly
+    // that level
+    if (Observer::levels && r.dist[u] != level) {
+      level = r.dist[u];
+      obs.begin_level(level, fifo.size());
+    }
+    fifo.pop_front();
+    for (int v : neighbours(g, u)) {
+      obs.examine_edge(u, v);
+      if (r.reached(v))
+        continue;
+      r.dist[v] = r.dist[u] + 1;
+      r.parent[v] = u;
+      fifo.push_back(v);
+      obs.discover_vertex(v);
+    }
+  }
+  return r;
+}
+
+template <class G> bfs_result bfs(const G &g, int s) {
+  null_observer obs;
+  return bfs(g, s, obs);
+}
+
+// direction-optimizing bfs (Beamer, Asanovic and Patterson)
+//
+// The plain bfs above is "top-down": every vertex of the frontier checks all
+// its out-edges for undiscovered vertices.  On low-diameter graphs (social
+// networks, web graphs...) the middle levels reach most of the graph, and
+// then most of those checks hit vertices that are already discovered.
+//
+// The "bottom-up" step turns this around: every undiscovered vertex v looks
+// at its in-edges for a parent in the frontier and stops at the first one
+// found.  When the frontier is big, v finds a parent after looking at a
+// few edges, and the vertices already discovered aren't looked at at all.
+// The frontier is kept as a bitmap there since the question asked is "is u
+// in the frontier?".
+//
+// Which step is cheaper is guessed from the sizes:
+//  m_f: edges to check from the frontier (sum of its out-degrees)
+//  m_u: edges to check from the undiscovered vertices
+//  n_f: vertices in the frontier
+// top-down -> bottom-up when m_f > m_u / alpha,
+// bottom-up -> top-down when n_f < n / beta (the frontier is small again).
+// alpha = 14 and beta = 24 are the values from the paper.
+//
+// gt is the transpose of g (see transpose() in csr.hpp), for an undirected
+// graph g itself can be passed.  The distances are exactly those of bfs().
+// The parents form a valid bfs tree, the same as the one of bfs() as long as
+// no level ran bottom-up (a bottom-up step keeps the first parent found in
+// the in-edges, not the first one in queue order).
+
+class bfs_counters {
+public:
+  size_t top_down_edges = 0;  // edges examined by the top-down steps
+  size_t bottom_up_edges = 0; // edges examined by the bottom-up steps
+  int top_down_levels = 0;
+  int bottom_up_levels = 0;
+};
+
+template <class G, class GT>
+bfs_result direction_optimizing_bfs(const G &g, const GT &gt, int s,
+                                    bfs_counters *counters = nullptr,
+                                    int alpha = 14, int beta = 24) {
+  int n = num_vertices(g);
+  assert(s < n && num_vertices(gt) == n);
+  bfs_counters local;
+  auto &c = counters ? *counters : local;
+  bfs_result r(n, s);
+
+  size_t m_u = 0;
+  for (int u = 0; u < n; ++u)
+    m_u += neighbours(g, u).size();
+
+  vector<int> queue, next_queue; // frontier for the top-down steps
+  bitmap front(n), next(n);      // frontier for the bottom-up steps
+  r.dist[s] = 0;
+  queue.push_back(s);
+  size_t m_f = neighbours(g, s).size();
+  m_u -= m_f;
+  size_t n_f = 1;
+  bool top_down = true;
+
+  for (int level = 0; n_f > 0; ++level) {
+    if (top_down && m_f > m_u / alpha) {
+      // switch to bottom-up, the frontier becomes a bitmap
+      top_down = false;
+      front.clear();
+      for (int u : queue)
+        front.set(u);
+    } else if (!top_down && n_f < static_cast<size_t>(n) / beta) {
+      // and back, the frontier becomes a queue
+      top_down = true;
+      queue.clear();
+      for (int u = 0; u < n; ++u)
+        if (front.test(u))
+          queue.push_back(u);
+    }
+
+    m_f = 0;
+    n_f = 0;
+    if (top_down) {
+      ++c.top_down_levels;
+      next_queue.clear();
+      for (int u : queue) {
+        for (int v : neighbours(g, u)) {
+          ++c.top_down_edges;
+          if (r.reached(v))
+            continue;
+          r.dist[v] = level + 1;
+          r.parent[v] = u;
+          next_queue.push_back(v);
+        }
+      }
+      queue.swap(next_queue);
+      n_f = queue.size();
+      for (int v : queue)
+        m_f += neighbours(g, v).size();
+    } else {
+      ++c.bottom_up_levels;
+      next.clear();
+      for (int v = 0; v < n; ++v) {
+        if (r.reached(v))
+          continue;
+        for (int u : neighbours(gt, v)) {
+          ++c.bottom_up_edges;
+          if (front.test(u)) {
+            r.dist[v] = level + 1;
+            r.parent[v] = u;
+            next.set(v);
+            ++n_f;
+            m_f += neighbours(g, v).size();
+            break;
+          }
+        }
+      }
+      front.swap(next);
+    }
+    m_u -= m_f;
+  }
+  return r;
+}
+
+// level-synchronous parallel bfs
+//
+// Each level the frontier is split among the threads of the pool (in
+// small dynamic blocks, one hub vertex can have more edges than the rest of
+// the frontier).  Two threads may find the same undiscovered vertex at the
+// same time, the one that wins the compare-and-swap of parent[v] from -1
+// discovers it, so the visited set is the parent array itself.  Each thread
+// collects the vertices it discovered in its own buffer, at the end of the
+// level the buffers are concatenated (in parallel) into the next frontier.
+//
+// The distances are those of bfs(), the parents form a valid bfs tree but
+// which of the tied parents wins depends on the scheduling.
+template <class G>
+bfs_result parallel_bfs(const G &g, int s, util::thread_pool &pool) {
+  int n = num_vertices(g);
+  assert(s < n);
+  const int threads = pool.size();
+  bfs_result r(n, s);
+  vector<std::atomic<int>> parent(n);
+  util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+    for (auto v = lo; v < hi; ++v)
+      parent[v].store(-1, std::memory_order_relaxed);
+  });
+  // the source is its own parent while the search runs so that nobody can
+  // claim it
+  parent[s].store(s, std::memory_order_relaxed);
+  r.dist[s] = 0;
+
+  vector<int> frontier(1, s), next;
+  vector<vector<int>> local(threads);
+  vector<size_t> offset(threads + 1);
+  for (int level = 0; !frontier.empty(); ++level) {
+    util::parallel_for_dynamic(
+        pool, 0, frontier.size(), 64, [&](size_t lo, size_t hi, int tid) {
+          auto &out = local[tid];
+          for (auto i = lo; i < hi; ++i) {
+            int u = frontier[i];
+            for (int v : neighbours(g, u)) {
+              // cheap test first, only try the CAS if it could succeed
+              if (parent[v].load(std::memory_order_relaxed) != -1)
+                continue;
+              int expected = -1;
+              if (parent[v].compare_exchange_strong(
+                      expected, u, std::memory_order_relaxed)) {
+                r.dist[v] = level + 1; // only the winner writes dist[v]
+                out.push_back(v);
+              }
+            }
+          }
+        });
+    offset[0] = 0;
+    for (int t = 0; t < threads; ++t)
+      offset[t + 1] = offset[t] + local[t].size();
+    next.resize(offset[threads]);
+    pool.run([&](int tid) {
+      std::copy(local[tid].begin(), local[tid].end(),
+                next.begin() + offset[tid]);
+      local[tid].clear();
+    });
+    frontier.swap(next);
+  }
+
+  util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+    for (auto v = lo; v < hi; ++v)
+      r.parent[v] = parent[v].load(std::memory_order_relaxed);
+  });
+  r.parent[s] = -1;
+  return r;
+}
+
+template <class G> bfs_result parallel_bfs(const G &g, int s, int threads) {
+  util::thread_pool pool(threads);
+  return parallel_bfs(g, s, pool);
+}
+
+// multi-source bfs (Then et al., "The More the Merrier")
+//
+// Running bfs() from many sources repeats the same adjacency scans over and
+// over.  Here up to 64 searches run together: each vertex has a 64 bit word
+// per state, bit i standing for the search from sources[i],
+//  seen[v]:  the searches that have already reached v
+//  visit[v]: the searches for which v is in the current frontier
+//  next[v]:  the searches for which v is in the next frontier
+// A single scan of the edges of v pushes visit[v] to all its neighbours at
+// once, whatever the number of searches having v in their frontier.
+//
+// Nothing is stored per (source, vertex), visit(i, v, d) is called as soon
+// as the search from sources[i] reaches v at distance d (including
+// (i, sources[i], 0)).  Eccentricities, closeness, hop histograms... can be
+// accumulated from there without materializing the distances.
+
+const int ms_bfs_width = 64;
+
+template <class G, class F>
+void multi_source_bfs(const G &g, const vector<int> &sources, F &&visit) {
+  int n = num_vertices(g);
+  assert(sources.size() <= static_cast<size_t>(ms_bfs_width));
+  vector<uint64_t> seen(n, 0), frontier(n, 0), next(n, 0);
+  for (size_t i = 0; i < sources.size(); ++i) {
+    int s = sources[i];
+    assert(s < n);
+    uint64_t bit = uint64_t(1) << i;
+    if (!(seen[s] & bit))
+      visit(static_cast<int>(i), s, 0);
+    seen[s] |= bit;
+    frontier[s] |= bit;
+  }
+  for (int level = 1;; ++level) {
+    bool more = false;
+    for (int v = 0; v < n; ++v) {
+      if (!frontier[v])
+        continue;
+      for (int u : neighbours(g, v))
+        next[u] |= frontier[v];
+    }
+    for (int v = 0; v < n; ++v) {
+      uint64_t reached = next[v] & ~seen[v];
+      next[v] = 0;
+      frontier[v] = reached;
+      if (!reached)
+        continue;
+      more = true;
+      seen[v] |= reached;
+      for (; reached; reached &= reached - 1)
+        visit(__builtin_ctzll(reached), v, level);
+    }
+    if (!more)
+      return;
+  }
+}
+
+// Every vertex as a source, in batches of 64.  visit(s, v, d) gets the
+// source vertex itself here, not its index in the batch.
+template <class G, class F> void all_sources_bfs(const G &g, F &&visit) {
+  int n = num_vertices(g);
+  vector<int> batch;
+  for (int first = 0; first < n; first += ms_bfs_width) {
+    batch.clear();
+    for (int s = first; s < n && s < first + ms_bfs_width; ++s)
+      batch.push_back(s);
+    multi_source_bfs(g, batch, [&](int i, int v, int d) {
+      visit(batch[i], v, d);
+    });
+  }
+}
+
+// dist[i][v] the distance from sources[i] to v, -1 if not reachable
+template <class G>
+vector<vector<int>> distance_matrix(const G &g, const vector<int> &sources) {
+  vector<vector<int>> dist(sources.size(), vector<int>(num_vertices(g), -1));
+  vector<int> batch;
+  for (size_t first = 0; first < sources.size(); first += ms_bfs_width) {
+    auto last = std::min(sources.size(), first + ms_bfs_width);
+    batch.assign(sources.begin() + first, sources.begin() + last);
+    multi_source_bfs(g, batch,
+                     [&](int i, int v, int d) { dist[first + i][v] = d; });
+  }
+  return dist;
+}
+
+// The path from r.source to v as a vertex list, empty if v isn't reachable.
+// Walks the parents up from v, no recursion: fine on any depth.
+inline vector<int> path_to(const bfs_result &r, int v) {
+  vector<int> path;
+  if (!r.reached(v))
+    return path;
+  for (; v >= 0; v = r.parent[v])
+    path.push_back(v);
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+// ids are printed 1-based as in the CLRS figures
+inline void print_path(const bfs_result &r, int s, int v) {
+  // up the parents to s, then printed from s down
+  vector<int> path;
+  for (int u = v;; u = r.parent[u]) {
+    path.push_back(u);
+    if (u == s)
+      break;
+    if (r.parent[u] < 0) {
+      cout << "no path between " << s + 1 << " and " << v + 1;
+      return;
+    }
+  }
+  for (auto it = path.rbegin(); it != path.rend(); ++it)
+    cout << *it + 1 << ",";
+}
+
+inline void print(const bfs_result &r, int s, int v) {
+  cout << "path between " << s + 1 << " and " << v + 1 << ": ";
+  print_path(r, s, v);
+  cout << "\n";
+}
+}
+}
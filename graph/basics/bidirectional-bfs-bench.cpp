@@ -0,0 +1,85 @@
+// point-to-point benchmark: bidirectional bfs against a full bfs per query
+//
+// g++ bidirectional-bfs-bench.cpp -std=c++14 -O2 -pthread
+// ./a.out [scale=18] [max threads=hardware threads]
+//
+// The inputs: an undirected R-MAT graph with 2^scale vertices and
+// 8 * 2^scale edges each way, and a square grid of about 2^scale vertices.
+// Random (s, t) pairs; for each method the queries per second and the
+// vertices visited per query, then shortest_paths on 1..N threads.
+
+#include "../../util/bench.hpp"
+#include "../../util/parallel.hpp"
+#include "bfs.hpp"
+#include "bidirectional-bfs.hpp"
+#include "csr.hpp"
+#include "generators.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+void run(const string &name, const csr_graph &g, int max_threads) {
+  const int n = g.num_vertices();
+  mt19937 rng(1);
+  vector<pair<int, int>> queries;
+  for (int q = 0; q < 2000; ++q)
+    queries.emplace_back(rng() % n, rng() % n);
+  printf("\n%s: vertices: %d, edges: %zu\n", name.c_str(), n, g.num_edges());
+  printf("%-24s %12s %16s\n", "method", "queries/s", "visited/query");
+
+  // a full bfs from s for a few of the queries, it's slow
+  const size_t few = 50;
+  vector<size_t> lengths(few);
+  double visited = 0;
+  double t_bfs = best_time(1, [&] {
+    for (size_t q = 0; q < few; ++q) {
+      auto r = bfs(g, queries[q].first);
+      lengths[q] = path_to(r, queries[q].second).size();
+      for (int d : r.dist)
+        visited += d >= 0;
+    }
+  });
+  printf("%-24s %12.1f %16.1f\n", "bfs + path_to", few / t_bfs,
+         visited / few);
+
+  path_workspace w(n);
+  visited = 0;
+  double t_bidir = best_time(1, [&] {
+    for (auto &q : queries) {
+      shortest_path(g, g, q.first, q.second, w);
+      visited += w.visited();
+    }
+  });
+  for (size_t q = 0; q < few; ++q)
+    assert(shortest_path(g, g, queries[q].first, queries[q].second, w)
+               .size() == lengths[q]);
+  printf("%-24s %12.1f %16.1f\n", "shortest_path",
+         queries.size() / t_bidir, visited / queries.size());
+
+  vector<int> counts;
+  for (int threads = 1; threads < max_threads; threads *= 2)
+    counts.push_back(threads);
+  counts.push_back(max_threads);
+  for (int threads : counts) {
+    thread_pool pool(threads);
+    double t = best_time(3, [&] { shortest_paths(g, g, queries, pool); });
+    printf("shortest_paths, %-8d %12.1f\n", threads, queries.size() / t);
+  }
+}
+
+int main(int argc, char **argv) {
+  int scale = argc > 1 ? atoi(argv[1]) : 18;
+  int max_threads = argc > 2 ? atoi(argv[2]) : hardware_threads();
+  int n = 1 << scale, side = static_cast<int>(sqrt(double(n)));
+  run("rmat", csr_graph(n, symmetrize(rmat_edges(scale, 8, 1))), max_threads);
+  run("grid", csr_graph(side * side, grid_edges(side, side)), max_threads);
+}
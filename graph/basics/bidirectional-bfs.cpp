@@ -0,0 +1,87 @@
+// point-to-point shortest paths, see bidirectional-bfs.hpp
+//
+// g++ bidirectional-bfs.cpp -std=c++14 -pthread
+
+#include "bfs.hpp"
+#include "bidirectional-bfs.hpp"
+#include "csr.hpp"
+#include "generators.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+// a path of g from s to t
+bool is_path(const csr_graph &g, const vector<int> &path, int s, int t) {
+  if (path.empty() || path.front() != s || path.back() != t)
+    return false;
+  for (size_t i = 1; i < path.size(); ++i) {
+    auto adj = neighbours(g, path[i - 1]);
+    if (find(adj.begin(), adj.end(), path[i]) == adj.end())
+      return false;
+  }
+  return true;
+}
+
+int main() {
+  // CLRS P.596 Figure 22.3 (undirected, 0-based): r s t u v w x y
+  vector<edge> clrs_edges = {{0, 1}, {0, 4}, {1, 5}, {5, 2}, {5, 6},
+                             {2, 6}, {2, 3}, {6, 3}, {6, 7}, {3, 7}};
+  csr_graph fig(8, symmetrize(clrs_edges));
+  auto p = shortest_path(fig, fig, 4, 7); // v to y
+  assert((p == vector<int>{4, 0, 1, 5, 6, 7}));
+  assert((shortest_path(fig, fig, 3, 3) == vector<int>{3}));
+
+  // directed: the way back goes through the transpose
+  csr_graph chain(5, {{0, 1}, {1, 2}, {2, 3}, {3, 4}});
+  auto back = transpose(chain);
+  assert((shortest_path(chain, back, 0, 4) == vector<int>{0, 1, 2, 3, 4}));
+  assert(shortest_path(chain, back, 4, 0).empty());
+
+  // random directed graphs: the same length as a bfs, a path of the graph
+  const int scale = 12, n = 1 << scale;
+  csr_graph g(n, rmat_edges(scale, 4, 1));
+  auto gt = transpose(g);
+  mt19937 rng(3);
+  path_workspace w(n);
+  vector<pair<int, int>> queries;
+  for (int q = 0; q < 300; ++q) {
+    int s = rng() % n, t = rng() % n;
+    queries.emplace_back(s, t);
+    auto expected = path_to(bfs(g, s), t);
+    auto path = shortest_path(g, gt, s, t, w);
+    assert(path.size() == expected.size());
+    assert(path.empty() || is_path(g, path, s, t));
+  }
+
+  // the queries side by side on a pool, a workspace per thread
+  for (int threads = 1; threads <= 4; ++threads) {
+    thread_pool pool(threads);
+    auto paths = shortest_paths(g, gt, queries, pool);
+    for (size_t q = 0; q < queries.size(); ++q)
+      assert(paths[q].size() ==
+             shortest_path(g, gt, queries[q].first, queries[q].second, w)
+                 .size());
+  }
+
+  // deep: the path and print_path rebuild a million vertices without
+  // recursion
+  const int deep = 1000000;
+  csr_graph line(deep, chain_edges(deep));
+  auto r = bfs(line, 0);
+  assert(path_to(r, deep - 1).size() == size_t(deep));
+  assert(shortest_path(line, transpose(line), 0, deep - 1).size() ==
+         size_t(deep));
+  cout.setstate(ios::failbit); // a million numbers to nowhere
+  print_path(r, 0, deep - 1);
+  cout.clear();
+  cout << "v to y: ";
+  for (int v : p)
+    cout << "rstuvwxy"[v] << " ";
+  cout << "\n";
+}
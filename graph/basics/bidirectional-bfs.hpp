@@ -0,0 +1,163 @@
+// point-to-point shortest paths: bidirectional bfs
+//
+// bfs(g, s) answers "how far is everything from s", but the usual question
+// is "what's the shortest path from s to t", and a bfs from s explores the
+// whole ball around s up to t, most of the graph on a small-world graph.
+// Bidirectional bfs grows two balls instead, one from s along the edges of
+// g and one from t along the edges of its transpose gt (the in-edges), one
+// level at a time, always the side whose frontier is smaller.  It stops as
+// soon as an edge joins the two: on a graph whose balls grow by a factor b
+// per level, that's two balls of radius d/2, about 2 b^(d/2) vertices
+// instead of b^d.
+//
+// The first edge u -> v found joining the sides gives a shortest path:
+// say u is in the frontier being expanded, at distance k from its end, and
+// v was reached by the other side at distance j.  v can only be in the
+// last level of the other side: when v was expanded, u would have been
+// reached from v (or the two would have met right then).  So every edge
+// found while expanding this level joins paths of length k + 1 + j, the
+// same j, and nothing shorter was found before.
+//
+// The state of a query lives in a path_workspace: what each vertex was
+// reached by and from where.  A vertex belongs to the current query when
+// its stamp is the query's, so a query costs the vertices it touches, not
+// an O(V) reset.  The graph is only read: many queries run at once on the
+// same graph, one workspace each (shortest_paths does that on a thread
+// pool).  For an undirected graph (both directions stored) gt is g itself.
+#pragma once
+
+#include "../../util/parallel.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::size_t;
+using std::uint32_t;
+using std::vector;
+
+class path_workspace {
+public:
+  path_workspace() {}
+  explicit path_workspace(int n) { resize(n); }
+
+  void resize(int n) {
+    _stamp.assign(n, 0);
+    _link.resize(n);
+    _query = 0;
+  }
+  int num_vertices() const { return static_cast<int>(_stamp.size()); }
+  // the vertices the last query reached, both sides
+  size_t visited() const { return _visited; }
+
+private:
+  template <class G, class GT>
+  friend vector<int> shortest_path(const G &, const GT &, int, int,
+                                   path_workspace &);
+
+  // starts a query: a new pair of stamps (forward, backward)
+  void next_query() {
+    if (_query >= UINT32_MAX - 2) {
+      std::fill(_stamp.begin(), _stamp.end(), 0);
+      _query = 0;
+    }
+    _query += 2;
+    _visited = 0;
+  }
+  uint32_t forward() const { return _query; }
+  uint32_t backward() const { return _query + 1; }
+
+  vector<uint32_t> _stamp; // which side of which query reached v
+  vector<int> _link;       // the vertex v was reached from, -1 at the ends
+  vector<int> _frontier[2], _next;
+  uint32_t _query = 0;
+  size_t _visited = 0;
+};
+
+// The vertices of a shortest path from s to t, s and t included; empty if t
+// isn't reachable from s.  gt is the transpose of g.
+template <class G, class GT>
+vector<int> shortest_path(const G &g, const GT &gt, int s, int t,
+                          path_workspace &w) {
+  const int n = num_vertices(g);
+  assert(s >= 0 && s < n && t >= 0 && t < n && num_vertices(gt) == n);
+  if (w.num_vertices() != n)
+    w.resize(n);
+  if (s == t)
+    return vector<int>(1, s);
+  w.next_query();
+  const uint32_t stamp[2] = {w.forward(), w.backward()};
+  w._stamp[s] = stamp[0];
+  w._stamp[t] = stamp[1];
+  w._link[s] = w._link[t] = -1;
+  w._visited = 2;
+  for (int side = 0; side < 2; ++side)
+    w._frontier[side].assign(1, side == 0 ? s : t);
+
+  // expands the frontier of one side by a level, returns the edge joining
+  // the sides if there's one, as (forward end, backward end)
+  auto expand = [&](int side, const auto &adj) {
+    auto &frontier = w._frontier[side];
+    w._next.clear();
+    for (int u : frontier)
+      for (int v : neighbours(adj, u)) {
+        if (w._stamp[v] == stamp[side])
+          continue;
+        if (w._stamp[v] == stamp[1 - side])
+          return side == 0 ? std::make_pair(u, v) : std::make_pair(v, u);
+        w._stamp[v] = stamp[side];
+        w._link[v] = u;
+        w._next.push_back(v);
+      }
+    w._visited += w._next.size();
+    frontier.swap(w._next);
+    return std::make_pair(-1, -1);
+  };
+
+  while (!w._frontier[0].empty() && !w._frontier[1].empty()) {
+    int side = w._frontier[0].size() <= w._frontier[1].size() ? 0 : 1;
+    auto meet = side == 0 ? expand(0, g) : expand(1, gt);
+    if (meet.first < 0)
+      continue;
+    // s ... meet.first, then meet.second ... t
+    vector<int> path;
+    for (int v = meet.first; v >= 0; v = w._link[v])
+      path.push_back(v);
+    std::reverse(path.begin(), path.end());
+    for (int v = meet.second; v >= 0; v = w._link[v])
+      path.push_back(v);
+    return path;
+  }
+  return vector<int>();
+}
+
+template <class G, class GT>
+vector<int> shortest_path(const G &g, const GT &gt, int s, int t) {
+  path_workspace w(num_vertices(g));
+  return shortest_path(g, gt, s, t, w);
+}
+
+// many queries at once, a workspace per thread of the pool
+template <class G, class GT>
+vector<vector<int>> shortest_paths(const G &g, const GT &gt,
+                                   const vector<std::pair<int, int>> &queries,
+                                   util::thread_pool &pool) {
+  vector<vector<int>> paths(queries.size());
+  vector<path_workspace> workspace(pool.size());
+  util::parallel_for_dynamic(pool, 0, queries.size(), 16,
+                             [&](size_t lo, size_t hi, int tid) {
+                               for (auto q = lo; q < hi; ++q)
+                                 paths[q] = shortest_path(
+                                     g, gt, queries[q].first,
+                                     queries[q].second, workspace[tid]);
+                             });
+  return paths;
+}
+}
+}
@@ -0,0 +1,50 @@
+// a fixed size bitmap, one bit per vertex
+//
+// vector<bool> would do the same, but here the words are exposed so that
+// whole-word operations (clear, count, scan for set bits, atomics) are
+// possible.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::size_t;
+using std::uint64_t;
+using std::vector;
+
+class bitmap {
+public:
+  bitmap() {}
+  explicit bitmap(size_t n) : _n(n), words((n + 63) / 64, 0) {}
+
+  bool test(size_t i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+  void set(size_t i) { words[i >> 6] |= uint64_t(1) << (i & 63); }
+  void reset(size_t i) { words[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+  void clear() {
+    for (auto &w : words)
+      w = 0;
+  }
+  size_t count() const {
+    size_t c = 0;
+    for (auto w : words)
+      c += __builtin_popcountll(w);
+    return c;
+  }
+  size_t size() const { return _n; }
+  void swap(bitmap &other) {
+    std::swap(_n, other._n);
+    words.swap(other.words);
+  }
+
+private:
+  size_t _n = 0;
+
+public:
+  vector<uint64_t> words;
+};
+}
+}
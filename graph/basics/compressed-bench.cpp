@@ -0,0 +1,81 @@
+// compressed adjacency benchmark: memory and traversal speed against CSR
+//
+// g++ compressed-bench.cpp -std=c++14 -O2 -pthread
+// ./a.out [scale=18]
+//
+// The inputs: an undirected R-MAT graph with 2^scale vertices and
+// 8 * 2^scale edges each way with shuffled ids, the same graph renumbered
+// in bfs order (reorder.hpp), and a square grid of about 2^scale vertices
+// in row-major order.  For each, the bytes per edge of the CSR and of the
+// compressed graph (offsets included) and the throughput of bfs, dfs and
+// tarjan_scc on both, in million edges per second.  The CSR lists are
+// sorted as well, so both forms see the very same traversal.
+
+#include "../../util/bench.hpp"
+#include "bfs.hpp"
+#include "compressed.hpp"
+#include "csr.hpp"
+#include "dfs.hpp"
+#include "generators.hpp"
+#include "reorder.hpp"
+#include "scc.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+vector<edge> shuffled(int n, const vector<edge> &edges, unsigned seed) {
+  vector<int> id(n);
+  for (int v = 0; v < n; ++v)
+    id[v] = v;
+  shuffle(id.begin(), id.end(), mt19937(seed));
+  vector<edge> r;
+  r.reserve(edges.size());
+  for (auto &e : edges)
+    r.emplace_back(id[e.first], id[e.second]);
+  return r;
+}
+
+template <class G> void traverse(const char *form, const G &g, size_t bytes) {
+  double m = g.num_edges();
+  int source = 0;
+  for (int v = 0; v < g.num_vertices(); ++v)
+    if (g.degree(v) > g.degree(source))
+      source = v;
+  double t_bfs = best_time(3, [&] { bfs(g, source); });
+  double t_dfs = best_time(3, [&] { dfs(g); });
+  double t_scc = best_time(3, [&] { tarjan_scc(g); });
+  printf("%-12s %10.2f %10.2f %10.2f %10.2f\n", form, bytes / m,
+         m / t_bfs / 1e6, m / t_dfs / 1e6, m / t_scc / 1e6);
+}
+
+void run(const string &name, const csr_graph &unsorted) {
+  // the lists sorted, as the compressed graph has them
+  auto g = relabel(unsorted, vertex_order::identity(unsorted.num_vertices()));
+  compressed_graph cg(g);
+  assert(bfs(cg, 0).dist == bfs(g, 0).dist);
+  printf("\n%s: vertices: %d, edges: %zu\n", name.c_str(), g.num_vertices(),
+         g.num_edges());
+  printf("%-12s %10s %10s %10s %10s\n", "form", "bytes/edge", "bfs", "dfs",
+         "scc");
+  traverse("csr", g,
+           g.targets.size() * sizeof(int) + g.offsets.size() * sizeof(size_t));
+  traverse("compressed", cg, cg.size_in_bytes());
+}
+
+int main(int argc, char **argv) {
+  int scale = argc > 1 ? atoi(argv[1]) : 18;
+  int n = 1 << scale, side = static_cast<int>(sqrt(double(n)));
+  csr_graph rmat(n, shuffled(n, symmetrize(rmat_edges(scale, 8, 1)), 2));
+  run("rmat, shuffled", rmat);
+  run("rmat, bfs order", relabel(rmat, bfs_order(rmat)));
+  run("grid", csr_graph(side * side, grid_edges(side, side)));
+}
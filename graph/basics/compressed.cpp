@@ -0,0 +1,81 @@
+// compressed adjacency lists, see compressed.hpp
+//
+// g++ compressed.cpp -std=c++14 -pthread
+
+#include "bfs.hpp"
+#include "compressed.hpp"
+#include "csr.hpp"
+#include "dfs.hpp"
+#include "generators.hpp"
+#include "reorder.hpp"
+#include "scc.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+
+int main() {
+  // the varints round trip, one byte up to 2^7-1, two up to 2^14-1...
+  for (uint32_t x : {0u, 1u, 127u, 128u, 16383u, 16384u, 2097151u, 2097152u,
+                     0xffffffffu}) {
+    vector<uint8_t> out;
+    put_varint(out, x);
+    const uint8_t *p = out.data();
+    assert(get_varint(p) == x && p == out.data() + out.size());
+    size_t expected = 1;
+    for (uint64_t limit = 128; x >= limit; limit <<= 7)
+      ++expected;
+    assert(out.size() == expected);
+  }
+  for (int x : {0, -1, 1, -2, 2, 1000000, -1000000})
+    assert(unzigzag(zigzag(x)) == x);
+  assert(zigzag(-1) == 1 && zigzag(1) == 2);
+
+  // the neighbours come out sorted, duplicates and empty lists included
+  vector<edge> edges = {{2, 9}, {2, 0}, {2, 5}, {2, 5}, {0, 300}, {0, 1},
+                        {9, 8}, {300, 2}};
+  compressed_graph small(301, edges);
+  vector<int> adj(neighbours(small, 2).begin(), neighbours(small, 2).end());
+  assert((adj == vector<int>{0, 5, 5, 9}));
+  assert(neighbours(small, 2).size() == 4 && small.degree(2) == 4);
+  assert(neighbours(small, 1).empty() && small.degree(1) == 0);
+  assert(*neighbours(small, 300).begin() == 2);
+  assert(small.num_edges() == edges.size());
+
+  // a graph goes through bfs, dfs and scc the same way in both forms
+  const int scale = 12, n = 1 << scale;
+  csr_graph g(n, rmat_edges(scale, 8, 1));
+  compressed_graph cg(g), from_edges(n, rmat_edges(scale, 8, 1));
+  assert(cg.bytes == from_edges.bytes && cg.offsets == from_edges.offsets);
+  // the csr lists sorted, which is what the compressed graph decodes
+  csr_graph sorted = relabel(g, vertex_order::identity(n));
+  for (int u = 0; u < n; ++u) {
+    auto a = neighbours(sorted, u);
+    auto b = neighbours(cg, u);
+    assert(equal(a.begin(), a.end(), b.begin(), b.end()));
+  }
+
+  auto br = bfs(cg, 0);
+  assert(br.dist == bfs(sorted, 0).dist && br.parent == bfs(sorted, 0).parent);
+  auto dr = dfs(cg), expected_dfs = dfs(sorted);
+  assert(dr.d == expected_dfs.d && dr.f == expected_dfs.f);
+  auto sr = tarjan_scc(cg), expected_scc = tarjan_scc(sorted);
+  assert(sr.count == expected_scc.count &&
+         sr.component == expected_scc.component);
+  compressed_graph cgt(transpose(g));
+  auto pr = parallel_scc(cg, cgt, 2);
+  assert(pr.count == expected_scc.count);
+  for (int u = 0; u < n; ++u)
+    for (int v : neighbours(cg, u))
+      assert((pr.component[u] == pr.component[v]) ==
+             (sr.component[u] == sr.component[v]));
+
+  cout << "csr: " << g.num_edges() * sizeof(int) +
+                         g.offsets.size() * sizeof(size_t)
+       << " bytes, compressed: " << cg.size_in_bytes() << " bytes, "
+       << cg.num_edges() << " edges\n";
+}
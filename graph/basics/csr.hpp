@@ -0,0 +1,169 @@
+// compressed sparse row (CSR) representation of graph
+//
+// fixed_graph stores a whole node object per edge and fixes V at compile
+// time.  For big graphs we want the opposite: V known only at runtime and
+// an edge costing nothing more than the id of its target.
+//
+// Representation: two flat arrays
+//  offsets: V+1 entries, the out-neighbours of u are
+//           targets[offsets[u] .. offsets[u+1])
+//  targets: E entries, the edge targets grouped by source vertex
+//
+// So the neighbours of a vertex are contiguous in memory and a scan over
+// them is a linear walk, no pointer chasing.
+//
+// The graph is built in bulk from an edge list with a counting sort on
+// the source vertex (O(V+E)), the order of the edges of the same source is
+// kept.  Once built it's read-only.
+#pragma once
+
+#include "graph.hpp"
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::pair;
+using std::size_t;
+using std::vector;
+
+using edge = pair<int, int>;
+
+class csr_graph {
+public:
+  csr_graph() : offsets(1, 0) {}
+  // n: number of vertices, every edge must satisfy 0 <= u, v < n
+  csr_graph(int n, const vector<edge> &edges) : offsets(n + 1, 0) {
+    targets.resize(edges.size());
+    for (auto &e : edges) {
+      assert(e.first >= 0 && e.first < n && e.second >= 0 && e.second < n);
+      ++offsets[e.first + 1];
+    }
+    for (int u = 0; u < n; ++u)
+      offsets[u + 1] += offsets[u];
+    // fill each bucket from its front, this keeps the input order
+    vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (auto &e : edges)
+      targets[next[e.first]++] = e.second;
+  }
+
+  int num_vertices() const { return static_cast<int>(offsets.size()) - 1; }
+  size_t num_edges() const { return targets.size(); }
+  size_t degree(int u) const { return offsets[u + 1] - offsets[u]; }
+
+  vector<size_t> offsets;
+  vector<int> targets;
+};
+
+// An input edge with a weight, and what out_edges() yields: the target of
+// an edge and its weight.
+template <class W> struct weighted_edge {
+  int from;
+  int to;
+  W weight;
+};
+
+template <class W> struct arc {
+  int to;
+  W weight;
+};
+
+// csr_graph plus a weight per edge, weights[i] being the weight of the edge
+// to targets[i].  It's still a csr_graph, the unweighted algorithms work on
+// it as is; the weighted ones go through
+//   out_edges(g, u) -> a range of arc<W> {to, weight}
+template <class W> class weighted_csr_graph : public csr_graph {
+public:
+  using weight_type = W;
+
+  weighted_csr_graph() {}
+  weighted_csr_graph(int n, const vector<weighted_edge<W>> &edges) {
+    offsets.assign(n + 1, 0);
+    targets.resize(edges.size());
+    weights.resize(edges.size());
+    for (auto &e : edges) {
+      assert(e.from >= 0 && e.from < n && e.to >= 0 && e.to < n);
+      ++offsets[e.from + 1];
+    }
+    for (int u = 0; u < n; ++u)
+      offsets[u + 1] += offsets[u];
+    vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (auto &e : edges) {
+      auto i = next[e.from]++;
+      targets[i] = e.to;
+      weights[i] = e.weight;
+    }
+  }
+
+  vector<W> weights;
+};
+
+// an undirected graph given by its edges listed once: each edge is stored
+// both ways
+template <class W>
+weighted_csr_graph<W> undirected_graph(int n,
+                                       const vector<weighted_edge<W>> &edges) {
+  vector<weighted_edge<W>> both(edges);
+  both.reserve(2 * edges.size());
+  for (auto &e : edges)
+    both.push_back(weighted_edge<W>{e.to, e.from, e.weight});
+  return weighted_csr_graph<W>(n, both);
+}
+
+// walks targets and weights side by side
+template <class W> class arc_iterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = arc<W>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const arc<W> *;
+  using reference = arc<W>;
+
+  arc_iterator() {}
+  arc_iterator(const int *to, const W *weight) : _to(to), _weight(weight) {}
+  arc<W> operator*() const { return arc<W>{*_to, *_weight}; }
+  arc_iterator &operator++() {
+    ++_to;
+    ++_weight;
+    return *this;
+  }
+  bool operator==(const arc_iterator &other) const { return _to == other._to; }
+  bool operator!=(const arc_iterator &other) const { return _to != other._to; }
+
+private:
+  const int *_to = nullptr;
+  const W *_weight = nullptr;
+};
+
+inline int num_vertices(const csr_graph &g) { return g.num_vertices(); }
+
+template <class W>
+range<arc_iterator<W>> out_edges(const weighted_csr_graph<W> &g, int u) {
+  auto first = g.offsets[u], last = g.offsets[u + 1];
+  return range<arc_iterator<W>>(
+      arc_iterator<W>(g.targets.data() + first, g.weights.data() + first),
+      arc_iterator<W>(g.targets.data() + last, g.weights.data() + last));
+}
+
+inline range<const int *> neighbours(const csr_graph &g, int u) {
+  auto base = g.targets.data();
+  return range<const int *>(base + g.offsets[u], base + g.offsets[u + 1]);
+}
+
+// The transpose G^T (every edge flipped), in CSR form whatever the
+// representation of g.  The neighbours of u in G^T are its in-neighbours in
+// G, which is what the algorithms walking edges backwards need.
+template <class G> csr_graph transpose(const G &g) {
+  int n = num_vertices(g);
+  vector<edge> edges;
+  for (int u = 0; u < n; ++u)
+    for (int v : neighbours(g, u))
+      edges.emplace_back(v, u);
+  return csr_graph(n, edges);
+}
+}
+}
@@ -1,70 +1,14 @@
+#include "csr.hpp"
+#include "dfs.hpp"
 #include "graph.hpp"
-#include <stack>
+#include "observer.hpp"
+#include <cassert>
+#include <iostream>
 #include <vector>
 
 using namespace std;
 using namespace clrs::graph;
 
-static int current_time = 0;
-
-template <class T, int V>
-void dfs_visit(fixed_graph<T, V> &g, int s, vector<bool> &visited,
-               stack<int> &stk) {
-  assert(s < g.graph.size());
-  g.graph[s].head.discovery_time = current_time;
-  dfs_node *predecessor = nullptr;
-  g.graph[s].head.prev = predecessor;
-  cout << "pushing guard: " << s << "\n";
-  stk.push(s + V);
-  cout << "pushing : " << s << "\n";
-  stk.push(s);
-  set_visited(visited, s);
-  while (!stk.empty()) {
-    auto u = stk.top();
-    stk.pop();
-
-    if (u >= V) {
-      g.graph[u - V].head.finish_time = ++current_time;
-      cout << "popping guard -->: " << u - V << ", f time: " << current_time
-           << "\n";
-      continue;
-    }
-    cout << "popping -->: " << u << "\n";
-
-    // set predecessor node
-    g.graph[u].head.prev = predecessor;
-
-    // I'm now the predecessor
-    predecessor = &g.graph[u].head;
-
-    for (auto &neighbour : g.graph[u].adj_list) {
-      if (visited[neighbour.id])
-        continue;
-      // first time visit, push a task to compute the finish time
-      // when this task (denoted by u+V, no such vertice exists) is popped
-      // it means all it's adjacency list has been explored and we'll
-      // mark it as finished
-      cout << "pushing guard : " << neighbour.id << "\n";
-      stk.push(neighbour.id + V);
-      g.graph[neighbour.id].head.discovery_time = ++current_time;
-      cout << "pushing : " << neighbour.id << ", d time: " << current_time
-           << "\n";
-      stk.push(neighbour.id);
-      set_visited(visited, neighbour.id);
-      // set discovery current_time
-    }
-  }
-}
-
-template <class T, int V> void dfs(fixed_graph<T, V> &g) {
-  stack<int> stk;
-  vector<bool> visited(g.graph.size(), false);
-  for (auto &l : g.graph) {
-    if (!visited[l.head.id])
-      dfs_visit(g, l.head.id, visited, stk);
-  }
-}
-
 int main() {
 
   fixed_graph<dfs_node, 5> g;
@@ -82,6 +26,36 @@ int main() {
   g.add(dfs_node(3), dfs_node(2));
   g.add(dfs_node(3), dfs_node(1));
   g.add(dfs_node(3), dfs_node(4));
-  dfs(g);
-  dump_graph(g);
+  // the trace shows the stack at work: each discover is a push, each finish
+  // a pop
+  trace_observer trace;
+  auto r = dfs(g, trace);
+  trace.print(cout);
+  cout << "--------------------\n";
+  for (int u = 0; u < 5; ++u)
+    cout << "id: " << u << ", dtime: " << r.d[u] << ", finish time: " << r.f[u]
+         << ", prev: " << r.parent[u] << "\n";
+  cout << "--------------------\n";
+  // 0 -> 1 -> 3 -> 2, then 3 -> 4
+  assert(r.d[0] == 1 && r.f[0] == 10);
+  assert(r.d[1] == 2 && r.f[1] == 9);
+  assert(r.d[3] == 3 && r.f[3] == 8);
+  assert(r.d[2] == 4 && r.f[2] == 5);
+  assert(r.d[4] == 6 && r.f[4] == 7);
+
+  // the same graph in CSR form goes through the very same dfs
+  vector<edge> edges = {{0, 1}, {0, 4}, {4, 0}, {4, 1}, {4, 3}, {1, 0}, {1, 3},
+                        {1, 4}, {1, 2}, {2, 1}, {2, 3}, {3, 2}, {3, 1}, {3, 4}};
+  csr_graph cg(5, edges);
+  auto cr = dfs(cg);
+  assert(cr.d == r.d);
+  assert(cr.f == r.f);
+  assert(cr.parent == r.parent);
+
+  // every vertex is pushed and popped once, every edge looked at once
+  counting_observer count;
+  dfs(cg, count);
+  assert(count.discovered == 5 && count.finished == 5);
+  assert(count.edges_examined == edges.size());
+  assert(count.max_stack_depth == 4); // 0 1 3 2, then 0 1 3 4
 }
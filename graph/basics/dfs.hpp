@@ -1,6 +1,10 @@
 #pragma once
 #include "graph.hpp"
+#include "observer.hpp"
+#include <cassert>
 #include <iostream>
+#include <stack>
+#include <vector>
 
 namespace clrs {
 namespace graph {
@@ -15,11 +19,12 @@ public:
   dfs_node(const dfs_node &other)
       : node(other), discovery_time(other.discovery_time),
         finish_time(other.finish_time) {}
+  dfs_node &operator=(const dfs_node &other) = default;
   int discovery_time;
   int finish_time;
 };
 
-ostream &operator<<(ostream &stream, const dfs_node &n) {
+inline ostream &operator<<(ostream &stream, const dfs_node &n) {
   stream << "id: " << n.id << ", dist: " << n.dist
          << ", dtime: " << n.discovery_time
          << ", finish time: " << n.finish_time << ", prev: ";
@@ -27,6 +32,91 @@ ostream &operator<<(ostream &stream, const dfs_node &n) {
     stream << n.prev->id;
   else
     stream << "null";
+  return stream;
+}
+
+// depth-first-search (CLRS 22.3)
+//
+// As for bfs, the timestamps and the predecessors are kept out of the graph
+// in dense arrays indexed by vertex id: d[v] (discovery_time), f[v]
+// (finish_time) and parent[v].  The clock follows CLRS, it starts at 0 and
+// each discovery or finish ticks it, so all the times are in 1..2V.
+class dfs_result {
+public:
+  dfs_result() {}
+  explicit dfs_result(int n) : d(n, -1), f(n, -1), parent(n, -1) {}
+  bool discovered(int v) const { return d[v] >= 0; }
+
+  vector<int> d;      // -1 until v is discovered
+  vector<int> f;      // -1 until v is finished
+  vector<int> parent; // -1 for the roots of the dfs forest
+  int time = 0;
+};
+
+// A frame of the explicit stack: a vertex and how far we've got in its
+// adjacency list.  Keeping the position (instead of pushing all the
+// neighbours at once) is what makes the discovery/finish times those of a
+// real depth-first search, and the stack never holds more than V frames.
+template <class It> struct dfs_frame {
+  int u;
+  It next;
+  It last;
+};
+
+// obs sees the pushes (discover_vertex), the pops (finish_vertex), the
+// edges and the stack depth, see observer.hpp
+template <class G, class Observer>
+void dfs_visit(const G &g, int s, dfs_result &r, Observer &obs) {
+  assert(s < num_vertices(g));
+  using iterator = decltype(neighbours(g, s).begin());
+  stack<dfs_frame<iterator>> stk;
+  auto discover = [&](int v) {
+    r.d[v] = ++r.time;
+    obs.discover_vertex(v);
+    auto adj = neighbours(g, v);
+    stk.push(dfs_frame<iterator>{v, adj.begin(), adj.end()});
+    obs.stack_depth(stk.size());
+  };
+  discover(s);
+  while (!stk.empty()) {
+    auto &top = stk.top();
+    // look for the next undiscovered neighbour of the top vertex
+    while (top.next != top.last && r.discovered(*top.next)) {
+      obs.examine_edge(top.u, *top.next);
+      ++top.next;
+    }
+    if (top.next == top.last) {
+      // the whole adjacency list has been explored, u is finished
+      r.f[top.u] = ++r.time;
+      obs.finish_vertex(top.u);
+      stk.pop();
+      continue;
+    }
+    int v = *top.next++;
+    obs.examine_edge(top.u, v);
+    r.parent[v] = top.u;
+    discover(v); // invalidates top
+  }
+}
+
+template <class G> void dfs_visit(const G &g, int s, dfs_result &r) {
+  null_observer obs;
+  dfs_visit(g, s, r, obs);
+}
+
+// Works on anything providing num_vertices()/neighbours() (see graph.hpp).
+template <class G, class Observer> dfs_result dfs(const G &g, Observer &obs) {
+  dfs_result r(num_vertices(g));
+  for (int u = 0; u < num_vertices(g); ++u) {
+    if (!r.discovered(u))
+      dfs_visit(g, u, r, obs);
+  }
+  return r;
+}
+
+template <class G> dfs_result dfs(const G &g) {
+  null_observer obs;
+  return dfs(g, obs);
 }
 }
 }
@@ -0,0 +1,81 @@
+// incremental bfs benchmark: repairing the distances after updates against
+// running bfs again
+//
+// g++ dynamic-graph-bench.cpp -std=c++14 -O2
+// ./a.out [scale=18]
+//
+// The inputs: an R-MAT graph with 2^scale vertices and 8 * 2^scale edges,
+// and a square grid (both directions) of about 2^scale vertices, the
+// source being the vertex of highest degree.  The updates: half random
+// insertions, half removals of an edge of the bfs tree (those are the ones
+// needing work, removing any other edge costs nothing).  For each batch
+// size, the mean time of a repair, the vertices it looked at, and the time
+// of a bfs from scratch on the same graph.
+
+#include "../../util/bench.hpp"
+#include "bfs.hpp"
+#include "dynamic-graph.hpp"
+#include "generators.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+void run(const string &name, int n, const vector<edge> &edges) {
+  dynamic_graph g(n, edges);
+  int source = 0;
+  for (int v = 0; v < n; ++v)
+    if (g.degree(v) > g.degree(source))
+      source = v;
+  dynamic_bfs b(g, source);
+  double full = best_time(3, [&] { bfs(g, source); });
+  printf("\n%s: vertices: %d, edges: %zu, bfs from scratch: %.3f ms\n",
+         name.c_str(), n, g.num_edges(), full * 1e3);
+  printf("%-8s %10s %14s %14s %10s\n", "batch", "batches", "ms per batch",
+         "touched", "speedup");
+
+  mt19937 rng(1);
+  auto random_update = [&] {
+    // a tree edge, if one is found (the removals may have cut the source
+    // off from everything)
+    if (rng() % 2)
+      for (int tries = 0; tries < n; ++tries) {
+        int v = rng() % n;
+        if (b.parent(v) >= 0)
+          return edge_update{b.parent(v), v, false};
+      }
+    return edge_update{int(rng() % n), int(rng() % n), true};
+  };
+  for (int batch : {1, 10, 100, 1000}) {
+    const int batches = batch >= 100 ? 20 : 200;
+    double total = 0;
+    size_t touched = 0;
+    for (int i = 0; i < batches; ++i) {
+      vector<edge_update> updates;
+      for (int k = 0; k < batch; ++k)
+        updates.push_back(random_update());
+      stopwatch w;
+      b.apply(updates);
+      total += w.seconds();
+      touched += b.touched();
+    }
+    double each = total / batches;
+    printf("%-8d %10d %14.4f %14.1f %10.1f\n", batch, batches, each * 1e3,
+           double(touched) / batches, full / each);
+  }
+  assert(b.result().dist == bfs(g, source).dist);
+}
+
+int main(int argc, char **argv) {
+  int scale = argc > 1 ? atoi(argv[1]) : 18;
+  int n = 1 << scale, side = static_cast<int>(sqrt(double(n)));
+  run("rmat", n, rmat_edges(scale, 8, 1));
+  run("grid", side * side, grid_edges(side, side));
+}
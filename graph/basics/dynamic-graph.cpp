@@ -0,0 +1,125 @@
+// dynamic graph and incremental bfs, see dynamic-graph.hpp
+//
+// g++ dynamic-graph.cpp -std=c++14
+
+#include "bfs.hpp"
+#include "dynamic-graph.hpp"
+#include "generators.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+
+// the repaired distances against a bfs from scratch, and the parents form
+// a shortest path tree of the current graph
+void check(const dynamic_graph &g, const dynamic_bfs &b) {
+  auto expected = bfs(g, b.source());
+  assert(b.result().dist == expected.dist);
+  for (int v = 0; v < g.num_vertices(); ++v) {
+    int p = b.parent(v);
+    if (v == b.source() || b.dist(v) < 0) {
+      assert(p == -1);
+      continue;
+    }
+    assert(g.has_edge(p, v) && b.dist(p) + 1 == b.dist(v));
+  }
+}
+
+int main() {
+  // 0 -> 1 -> 2 -> 3, and a longer way 0 -> 4 -> 5 -> 3
+  dynamic_graph g(6, {{0, 1}, {1, 2}, {2, 3}, {0, 4}, {4, 5}, {5, 3}});
+  dynamic_bfs b(g, 0);
+  assert(b.dist(3) == 3);
+  assert(!b.add_edge(0, 1)); // already there
+  assert(b.add_edge(0, 2));
+  assert(b.dist(3) == 2 && b.parent(3) == 2 && b.parent(2) == 0);
+  assert(b.remove_edge(0, 2)); // back to 3, through 1 (or 5)
+  assert(b.dist(2) == 2 && b.dist(3) == 3);
+  check(g, b);
+  assert(b.remove_edge(0, 1) && b.dist(1) == -1 && b.dist(2) == -1);
+  assert(b.dist(3) == 3 && b.parent(3) == 5);
+  assert(!b.remove_edge(0, 1));
+  check(g, b);
+  b.apply({{0, 1, true}, {3, 2, true}, {0, 1, false}});
+  assert(b.dist(1) == -1 && b.dist(2) == 4);
+  check(g, b);
+
+  // random updates on an R-MAT graph, one at a time and in batches
+  const int scale = 10, n = 1 << scale;
+  auto edges = rmat_edges(scale, 4, 1);
+  dynamic_graph rg(n, edges);
+  int s = 0;
+  for (int v = 0; v < n; ++v)
+    if (rg.degree(v) > rg.degree(s))
+      s = v;
+  dynamic_bfs rb(rg, s);
+  check(rg, rb);
+  mt19937 rng(2);
+  auto random_update = [&] {
+    // a removal: half of the time the tree edge of a random vertex (when
+    // it has one), the ones that need work, else a random edge
+    if (rng() % 2 && rg.num_edges() > 0) {
+      int v = rng() % n;
+      int u = rb.parent(v);
+      if (u < 0 || rng() % 2) {
+        do
+          u = rng() % n;
+        while (rg.out(u).empty());
+        auto l = rg.out(u);
+        v = l.begin()[rng() % l.size()];
+      }
+      return edge_update{u, v, false};
+    }
+    return edge_update{int(rng() % n), int(rng() % n), true};
+  };
+  for (int i = 0; i < 2000; ++i) {
+    rb.apply({random_update()});
+    if (i % 50 == 0)
+      check(rg, rb);
+  }
+  check(rg, rb);
+  for (int batch : {2, 10, 100, 1000}) {
+    vector<edge_update> updates;
+    for (int i = 0; i < batch; ++i)
+      updates.push_back(random_update());
+    rb.apply(updates);
+    check(rg, rb);
+  }
+
+  // churn, then mostly removals: after compact() the buffer is less than
+  // twice the entries of the lists, out and in
+  auto entries = [&] { return 2 * rg.num_edges(); };
+  size_t slots = 0;
+  for (int i = 0; i < 20000; ++i) {
+    int u = rng() % n;
+    if (!rg.out(u).empty())
+      rg.remove_edge(u, *rg.out(u).begin());
+    rg.add_edge(rng() % n, rng() % n);
+    slots = max(slots, rg.buffer_size());
+  }
+  rg.compact();
+  cout << "edges: " << rg.num_edges() << ", buffer: " << rg.buffer_size()
+       << " slots, at most " << slots << "\n";
+  assert(rg.buffer_size() < 2 * entries());
+  for (int u = 0; u < n; ++u)
+    while (rg.degree(u) > static_cast<size_t>(u % 3))
+      rg.remove_edge(u, *rg.out(u).begin());
+  rg.compact();
+  cout << "edges: " << rg.num_edges() << ", buffer: " << rg.buffer_size()
+       << " slots\n";
+  assert(rg.buffer_size() < 2 * entries());
+  for (int u = 0; u < n; ++u)
+    while (rg.degree(u) > 0)
+      rg.remove_edge(u, *rg.out(u).begin());
+  rg.compact();
+  assert(rg.num_edges() == 0 && rg.buffer_size() == 0);
+  // and it grows again
+  for (int i = 0; i < 1000; ++i)
+    rg.add_edge(rng() % n, rng() % n);
+  rg.compact();
+  assert(rg.buffer_size() < 2 * entries());
+}
@@ -0,0 +1,369 @@
+// a mutable graph, and bfs distances kept up to date as it changes
+//
+// dynamic_graph: edges come and go.  The adjacency lists (out and in, both
+// are needed to repair the distances) all live in one buffer of ints, each
+// list in a segment with some spare capacity:
+//  - an insertion writes in the spare slot, a full segment moves to the
+//    end of the buffer with twice the capacity (amortized O(1), like a
+//    vector), its old slots become a hole,
+//  - a removal swaps the last entry of the list into the hole (O(degree)
+//    to find it),
+//  - compact() slides the segments down over the holes in place, each
+//    shrunk to the power of two >= its size (none for an empty list), so
+//    right after it the buffer is less than twice the entries of the
+//    lists.  O(V lgV + E).  It runs by itself when the holes add up to
+//    half of the buffer; removals leave spare capacity rather than holes,
+//    call it after many of them.
+// So the graph is always one block of memory, and nothing is allocated per
+// edge.  It's a simple graph: an edge is there or
+// not, add_edge/remove_edge say whether they changed anything.
+//
+// dynamic_bfs: the bfs_result (dist and parent) of a source on a
+// dynamic_graph, repaired after each update instead of computed again.
+//  - insertion of u -> v: if it gives v a shorter distance, the decrease
+//    propagates from v as in a bfs, through the vertices it improves only.
+//  - removal of u -> v: nothing to do unless it's a tree edge
+//    (parent[v] == u).  Then the vertices of the subtree of v are looked at
+//    level by level: one with an in-neighbour one level up that is not
+//    affected keeps its distance (the neighbour becomes its parent) and its
+//    subtree is safe, the others are affected.  The affected ones get the
+//    best distance through their safe in-neighbours, and those distances
+//    propagate among them as in a bfs started from all of them at once
+//    (Ramalingam and Reps, for unit weights).
+// The work is proportional to the vertices whose distance or parent
+// changes and their edges, not to the graph.  A batch of updates is applied
+// to the graph first and repaired in one go: the removals, then the
+// insertions.
+//
+// All the updates must go through the dynamic_bfs once it's attached to the
+// graph.
+#pragma once
+
+#include "bfs.hpp"
+#include "csr.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::size_t;
+using std::vector;
+
+class dynamic_graph {
+public:
+  explicit dynamic_graph(int n = 0) : _out(n), _in(n) {}
+  dynamic_graph(int n, const vector<edge> &edges) : dynamic_graph(n) {
+    for (auto &e : edges)
+      add_edge(e.first, e.second);
+  }
+
+  int num_vertices() const { return static_cast<int>(_out.size()); }
+  size_t num_edges() const { return _edges; }
+  size_t degree(int u) const { return _out[u].size; }
+  size_t in_degree(int u) const { return _in[u].size; }
+  // the slots of the buffer, holes included
+  size_t buffer_size() const { return _slots.size(); }
+
+  int add_vertex() {
+    _out.emplace_back();
+    _in.emplace_back();
+    return num_vertices() - 1;
+  }
+
+  bool has_edge(int u, int v) const {
+    auto l = out(u);
+    return std::find(l.begin(), l.end(), v) != l.end();
+  }
+
+  bool add_edge(int u, int v) {
+    assert(u >= 0 && u < num_vertices() && v >= 0 && v < num_vertices());
+    if (has_edge(u, v))
+      return false;
+    append(_out[u], v);
+    append(_in[v], u);
+    ++_edges;
+    return true;
+  }
+
+  bool remove_edge(int u, int v) {
+    assert(u >= 0 && u < num_vertices() && v >= 0 && v < num_vertices());
+    if (!erase(_out[u], v))
+      return false;
+    erase(_in[v], u);
+    --_edges;
+    return true;
+  }
+
+  range<const int *> out(int u) const { return list(_out[u]); }
+  range<const int *> in(int u) const { return list(_in[u]); }
+
+  // slides the lists down over the holes, with just enough capacity
+  void compact() {
+    vector<segment *> by_position;
+    by_position.reserve(2 * _out.size());
+    for (auto *lists : {&_out, &_in})
+      for (auto &s : *lists)
+        if (s.capacity > 0)
+          by_position.push_back(&s);
+    std::sort(by_position.begin(), by_position.end(),
+              [](const segment *a, const segment *b) {
+                return a->first < b->first;
+              });
+    size_t end = 0;
+    for (auto *s : by_position) {
+      // the lists are in order, end <= s->first: the copy goes down
+      std::copy(_slots.begin() + s->first, _slots.begin() + s->first + s->size,
+                _slots.begin() + end);
+      // never more than before, the copies keep going down
+      size_t capacity = s->size > 0 ? 1 : 0;
+      while (capacity < s->size)
+        capacity *= 2;
+      s->first = end;
+      s->capacity = capacity;
+      end += capacity;
+    }
+    _slots.resize(end);
+    _holes = 0;
+  }
+
+private:
+  struct segment {
+    size_t first = 0;
+    size_t size = 0;
+    size_t capacity = 0;
+  };
+
+  range<const int *> list(const segment &s) const {
+    auto p = _slots.data() + s.first;
+    return range<const int *>(p, p + s.size);
+  }
+
+  void append(segment &s, int v) {
+    if (s.size == s.capacity) {
+      size_t capacity = std::max<size_t>(4, 2 * s.capacity);
+      if (s.capacity > 0 && s.first + s.capacity == _slots.size()) {
+        // the last segment of the buffer grows in place
+        _slots.resize(s.first + capacity);
+      } else {
+        size_t first = _slots.size();
+        _slots.resize(first + capacity);
+        std::copy(_slots.begin() + s.first, _slots.begin() + s.first + s.size,
+                  _slots.begin() + first);
+        _holes += s.capacity;
+        s.first = first;
+      }
+      s.capacity = capacity;
+    }
+    _slots[s.first + s.size++] = v;
+    if (2 * _holes > _slots.size())
+      compact();
+  }
+
+  bool erase(segment &s, int v) {
+    auto first = _slots.begin() + s.first, last = first + s.size;
+    auto it = std::find(first, last, v);
+    if (it == last)
+      return false;
+    *it = *(last - 1);
+    --s.size;
+    return true;
+  }
+
+  vector<segment> _out, _in;
+  vector<int> _slots;
+  size_t _holes = 0; // slots no segment owns
+  size_t _edges = 0;
+};
+
+inline int num_vertices(const dynamic_graph &g) { return g.num_vertices(); }
+
+inline range<const int *> neighbours(const dynamic_graph &g, int u) {
+  return g.out(u);
+}
+
+// an edge to add or remove
+struct edge_update {
+  int from;
+  int to;
+  bool insert;
+};
+
+class dynamic_bfs {
+public:
+  dynamic_bfs(dynamic_graph &g, int source)
+      : _g(g), _r(bfs(g, source)), _state(g.num_vertices(), unseen) {}
+
+  const bfs_result &result() const { return _r; }
+  int source() const { return _r.source; }
+  int dist(int v) const { return _r.dist[v]; }
+  int parent(int v) const { return _r.parent[v]; }
+  // the vertices the last repair looked at
+  size_t touched() const { return _touched; }
+
+  int add_vertex() {
+    _r.dist.push_back(-1);
+    _r.parent.push_back(-1);
+    _state.push_back(unseen);
+    return _g.add_vertex();
+  }
+
+  bool add_edge(int u, int v) {
+    return apply(vector<edge_update>{edge_update{u, v, true}}) > 0;
+  }
+  bool remove_edge(int u, int v) {
+    return apply(vector<edge_update>{edge_update{u, v, false}}) > 0;
+  }
+
+  // the updates in order, returns how many changed the graph
+  size_t apply(const vector<edge_update> &updates) {
+    size_t changed = 0;
+    _touched = 0;
+    _cut.clear();
+    _added.clear();
+    for (auto &e : updates) {
+      if (e.insert ? !_g.add_edge(e.from, e.to)
+                   : !_g.remove_edge(e.from, e.to))
+        continue;
+      ++changed;
+      if (e.insert)
+        _added.push_back(edge{e.from, e.to});
+      else if (_r.parent[e.to] == e.from)
+        _cut.push_back(e.to);
+    }
+    if (!_cut.empty())
+      repair_removals();
+    if (!_added.empty())
+      repair_insertions();
+    return changed;
+  }
+
+private:
+  enum state : char { unseen, safe, affected };
+  using entry = std::pair<int, int>; // a vertex and its dist when queued
+
+  static bool shorter(int d, int than) { return than < 0 || d < than; }
+
+  // The vertices whose tree edge was removed and their subtrees, by
+  // increasing distance: each is safe if it has an in-neighbour one level
+  // up that isn't affected, affected otherwise (and then its children in
+  // the tree are looked at).
+  void repair_removals() {
+    _seeds.clear();
+    for (int v : _cut)
+      _seeds.push_back(entry(v, _r.dist[v]));
+    sort_by_dist(_seeds);
+    _fifo.clear();
+    _examined.clear();
+    merge_queues([&](int x) {
+      if (_state[x] != unseen || _r.parent[x] < 0)
+        return;
+      _examined.push_back(x);
+      int d = _r.dist[x];
+      for (int y : _g.in(x))
+        if (_state[y] != affected && _r.dist[y] == d - 1) {
+          _state[x] = safe;
+          _r.parent[x] = y;
+          return;
+        }
+      _state[x] = affected;
+      for (int w : _g.out(x))
+        if (_r.parent[w] == x)
+          _fifo.push_back(entry(w, d + 1));
+    });
+    // the affected vertices start from their safe in-neighbours
+    _seeds.clear();
+    for (int x : _examined)
+      if (_state[x] == affected) {
+        _r.dist[x] = _r.parent[x] = -1;
+        for (int y : _g.in(x))
+          if (_state[y] != affected && _r.dist[y] >= 0 &&
+              shorter(_r.dist[y] + 1, _r.dist[x])) {
+            _r.dist[x] = _r.dist[y] + 1;
+            _r.parent[x] = y;
+          }
+      }
+    for (int x : _examined) {
+      if (_state[x] == affected && _r.dist[x] >= 0)
+        _seeds.push_back(entry(x, _r.dist[x]));
+      _state[x] = unseen;
+    }
+    propagate();
+  }
+
+  // the edges added that shorten the distance of their target (and are
+  // still there, the batch may have removed them again)
+  void repair_insertions() {
+    _seeds.clear();
+    for (auto &e : _added) {
+      int u = e.first, v = e.second;
+      if (_r.dist[u] >= 0 && shorter(_r.dist[u] + 1, _r.dist[v]) &&
+          _g.has_edge(u, v)) {
+        _r.dist[v] = _r.dist[u] + 1;
+        _r.parent[v] = u;
+        _seeds.push_back(entry(v, _r.dist[v]));
+      }
+    }
+    propagate();
+  }
+
+  // a bfs from all the seeds at once: every vertex queued has just got a
+  // shorter distance, its out-neighbours may get one too
+  void propagate() {
+    sort_by_dist(_seeds);
+    _fifo.clear();
+    merge_queues([&](int x) {
+      for (int w : _g.out(x))
+        if (shorter(_r.dist[x] + 1, _r.dist[w])) {
+          _r.dist[w] = _r.dist[x] + 1;
+          _r.parent[w] = x;
+          _fifo.push_back(entry(w, _r.dist[w]));
+        }
+    });
+  }
+
+  static void sort_by_dist(vector<entry> &q) {
+    std::sort(q.begin(), q.end(), [](const entry &a, const entry &b) {
+      return a.second < b.second;
+    });
+  }
+
+  // Visits the seeds (sorted) and what visit pushes on the fifo, by
+  // increasing distance: the fifo is sorted as well since what's pushed is
+  // one level below what's visited.  An entry whose vertex has changed
+  // distance since it was queued is stale and skipped.
+  template <class F> void merge_queues(F &&visit) {
+    size_t i = 0;
+    while (i < _seeds.size() || !_fifo.empty()) {
+      entry e;
+      if (_fifo.empty() ||
+          (i < _seeds.size() && _seeds[i].second <= _fifo.front().second)) {
+        e = _seeds[i++];
+      } else {
+        e = _fifo.front();
+        _fifo.pop_front();
+      }
+      if (_r.dist[e.first] != e.second)
+        continue;
+      ++_touched;
+      visit(e.first);
+    }
+  }
+
+  dynamic_graph &_g;
+  bfs_result _r;
+  vector<state> _state;
+  size_t _touched = 0;
+  // scratch, kept from one update to the next
+  vector<int> _cut, _examined;
+  vector<edge> _added;
+  vector<entry> _seeds;
+  std::deque<entry> _fifo;
+};
+}
+}
@@ -0,0 +1,153 @@
+// synthetic graphs for the examples and the benchmarks
+//
+// All generators are seeded, the same arguments always give the same edge
+// list, so that two runs (or two versions of the code) see the same input.
+#pragma once
+
+#include "csr.hpp"
+#include <algorithm>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::vector;
+
+// R-MAT (Chakrabarti, Zhan and Faloutsos), the generator of the Graph500:
+// 2^scale vertices and edge_factor * 2^scale edges.  Each edge picks its
+// quadrant of the adjacency matrix recursively with probabilities a, b, c
+// and 1-a-b-c, which gives the skewed degrees of real-world graphs.  It's
+// a stochastic Kronecker graph with the 2x2 initiator [a b; c d].
+inline vector<edge> rmat_edges(int scale, int edge_factor, unsigned seed,
+                               double a = 0.57, double b = 0.19,
+                               double c = 0.19) {
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> coin(0.0, 1.0);
+  const long long m = static_cast<long long>(edge_factor) << scale;
+  vector<edge> edges;
+  edges.reserve(m);
+  for (long long i = 0; i < m; ++i) {
+    int u = 0, v = 0;
+    for (int bit = 0; bit < scale; ++bit) {
+      double p = coin(rng);
+      u <<= 1;
+      v <<= 1;
+      if (p < a) {
+      } else if (p < a + b) {
+        v |= 1;
+      } else if (p < a + b + c) {
+        u |= 1;
+      } else {
+        u |= 1;
+        v |= 1;
+      }
+    }
+    edges.emplace_back(u, v);
+  }
+  // R-MAT puts the hubs on the low ids, scramble the ids so that the
+  // locality isn't artificially good
+  vector<int> perm(1 << scale);
+  for (int i = 0; i < (1 << scale); ++i)
+    perm[i] = i;
+  std::shuffle(perm.begin(), perm.end(), rng);
+  for (auto &e : edges)
+    e = edge(perm[e.first], perm[e.second]);
+  return edges;
+}
+
+// Erdos-Renyi G(n, m): m edges with uniformly random endpoints
+inline vector<edge> erdos_renyi_edges(int n, long long m, unsigned seed) {
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<int> vertex(0, n - 1);
+  vector<edge> edges;
+  edges.reserve(m);
+  for (long long i = 0; i < m; ++i) {
+    int u = vertex(rng);
+    edges.emplace_back(u, vertex(rng));
+  }
+  return edges;
+}
+
+// rows x cols 2D grid, vertex r * cols + c linked to its right and lower
+// neighbours, both ways: a road-network like graph, low degree and a large
+// diameter (rows + cols)
+inline vector<edge> grid_edges(int rows, int cols) {
+  vector<edge> edges;
+  edges.reserve(4LL * rows * cols);
+  for (int r = 0; r < rows; ++r)
+    for (int c = 0; c < cols; ++c) {
+      int u = r * cols + c;
+      if (c + 1 < cols) {
+        edges.emplace_back(u, u + 1);
+        edges.emplace_back(u + 1, u);
+      }
+      if (r + 1 < rows) {
+        edges.emplace_back(u, u + cols);
+        edges.emplace_back(u + cols, u);
+      }
+    }
+  return edges;
+}
+
+// the path 0 -> 1 -> ... -> n-1, the worst case for anything recursive or
+// level synchronous; cycle adds n-1 -> 0
+inline vector<edge> chain_edges(int n, bool cycle = false) {
+  vector<edge> edges;
+  edges.reserve(n);
+  for (int u = 0; u + 1 < n; ++u)
+    edges.emplace_back(u, u + 1);
+  if (cycle && n > 1)
+    edges.emplace_back(n - 1, 0);
+  return edges;
+}
+
+// A random DAG: m edges going forward in a random order of the n
+// vertices (so the ids say nothing of the topological order), no loop.
+inline vector<edge> random_dag_edges(int n, long long m, unsigned seed) {
+  std::mt19937_64 rng(seed);
+  vector<int> order(n);
+  for (int i = 0; i < n; ++i)
+    order[i] = i;
+  std::shuffle(order.begin(), order.end(), rng);
+  std::uniform_int_distribution<int> position(0, n - 1);
+  vector<edge> edges;
+  edges.reserve(m);
+  while (n > 1 && static_cast<long long>(edges.size()) < m) {
+    int i = position(rng), j = position(rng);
+    if (i == j)
+      continue;
+    if (i > j)
+      std::swap(i, j);
+    edges.emplace_back(order[i], order[j]);
+  }
+  return edges;
+}
+
+// add the reverse of every edge, for the undirected versions
+inline vector<edge> symmetrize(vector<edge> edges) {
+  auto m = edges.size();
+  edges.reserve(2 * m);
+  for (size_t i = 0; i < m; ++i)
+    edges.emplace_back(edges[i].second, edges[i].first);
+  return edges;
+}
+
+// the same edges with weights drawn uniformly in [lo, hi]
+template <class W>
+vector<weighted_edge<W>> with_random_weights(const vector<edge> &edges, W lo,
+                                             W hi, unsigned seed) {
+  using distribution = typename std::conditional<
+      std::is_integral<W>::value, std::uniform_int_distribution<W>,
+      std::uniform_real_distribution<W>>::type;
+  std::mt19937_64 rng(seed);
+  distribution weight(lo, hi);
+  vector<weighted_edge<W>> weighted;
+  weighted.reserve(edges.size());
+  for (auto &e : edges)
+    weighted.push_back(weighted_edge<W>{e.first, e.second, weight(rng)});
+  return weighted;
+}
+}
+}
@@ -0,0 +1,80 @@
+// loading benchmark: text edge list parsing vs mapping a binary graph file
+//
+// g++ graph-io-bench.cpp -std=c++14 -O2 -pthread
+// ./a.out [scale=20] [max threads=hardware threads]
+//
+// An R-MAT graph (2^scale vertices, 16 * 2^scale edges) is written as a
+// text edge list, parsed with 1, 2, 4... threads, converted to CSR and
+// written as a binary graph file.  The binary file is then opened again
+// and again (hot in the page cache) and traversed in place by a bfs.
+// The files are written in the current directory and removed at the end.
+
+#include "../../util/bench.hpp"
+#include "../../util/parallel.hpp"
+#include "bfs.hpp"
+#include "csr.hpp"
+#include "generators.hpp"
+#include "graph-io.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+int main(int argc, char **argv) {
+  int scale = argc > 1 ? atoi(argv[1]) : 20;
+  int max_threads = argc > 2 ? atoi(argv[2]) : hardware_threads();
+  const char *text = "graph-io-bench.txt", *binary = "graph-io-bench.bin";
+  auto edges = rmat_edges(scale, 16, 1);
+  {
+    FILE *f = fopen(text, "w");
+    for (auto &e : edges)
+      fprintf(f, "%d\t%d\n", e.first, e.second);
+    fclose(f);
+  }
+  printf("%zu edges\n", edges.size());
+  printf("%-28s %10s %12s\n", "step", "seconds", "Medges/s");
+  auto report = [&](const string &step, double t) {
+    printf("%-28s %10.4f %12.2f\n", step.c_str(), t, edges.size() / t / 1e6);
+  };
+
+  edge_list<edge> parsed;
+  for (int threads = 1;; threads = min(2 * threads, max_threads)) {
+    thread_pool pool(threads);
+    double t = best_time(3, [&] { parsed = read_edge_list(text, pool); });
+    report("parse text x" + to_string(threads), t);
+    if (threads == max_threads)
+      break;
+  }
+  assert(parsed.edges == edges);
+  csr_graph g;
+  report("build csr", best_time(3, [&] {
+           g = csr_graph(parsed.num_vertices, parsed.edges);
+         }));
+  report("write binary", best_time(3, [&] { write_graph(binary, g); }));
+
+  int n = 0;
+  report("open binary (hot)", best_time(10, [&] {
+           mapped_graph m(binary);
+           n = m.num_vertices();
+         }));
+  assert(n == g.num_vertices());
+  int s = 0;
+  for (int v = 0; v < n; ++v)
+    if (g.degree(v) > g.degree(s))
+      s = v;
+  bfs_result expected, r;
+  report("bfs on csr", best_time(3, [&] { expected = bfs(g, s); }));
+  report("open binary + bfs", best_time(3, [&] {
+           mapped_graph m(binary);
+           r = bfs(m, s);
+         }));
+  assert(r.dist == expected.dist);
+  remove(text);
+  remove(binary);
+}
@@ -0,0 +1,195 @@
+// text edge lists and binary graph files, see graph-io.hpp
+//
+// g++ graph-io.cpp -std=c++14 -pthread
+//
+// Writes its files in the current directory and removes them at the end.
+
+#include "../../util/bench.hpp"
+#include "../../util/parallel.hpp"
+#include "../single-source-shortest-path/sssp.hpp"
+#include "bfs.hpp"
+#include "csr.hpp"
+#include "generators.hpp"
+#include "graph-io.hpp"
+#include "scc.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+template <class G, class H> bool same_adjacency(const G &g, const H &h) {
+  if (num_vertices(g) != num_vertices(h))
+    return false;
+  for (int u = 0; u < num_vertices(g); ++u) {
+    auto a = neighbours(g, u), b = neighbours(h, u);
+    if (!equal(a.begin(), a.end(), b.begin(), b.end()))
+      return false;
+  }
+  return true;
+}
+
+int main() {
+
+  // CLRS P.659 Figure 24.6 as a text file, with the usual noise
+  {
+    ofstream text("graph-io-small.txt");
+    text << "# r s t x y z\n"
+         << "% weighted\n"
+         << "0 1 5\n0 2 3\n"
+         << "1 2 2\t\n1 3 6\r\n"
+         << "\n"
+         << "2 3 7\n2 4 4\n2 5 2\n3 4 -1\n3 5 1\n4,5,-2"; // no last '\n'
+  }
+  thread_pool pool(3), one(1);
+  auto small = read_weighted_edge_list<int>("graph-io-small.txt", pool);
+  assert(small.num_vertices == 6 && small.edges.size() == 10);
+  assert(small.edges[3].from == 1 && small.edges[3].to == 3 &&
+         small.edges[3].weight == 6);
+  assert(small.edges[9].weight == -2);
+  auto unweighted = read_edge_list("graph-io-small.txt", one);
+  assert(unweighted.edges.size() == 10 && unweighted.edges[9] == edge(4, 5));
+
+  weighted_csr_graph<int> g(small.num_vertices, small.edges);
+  vector<string> names = {"r", "s", "t", "x", "y", "z"};
+  write_graph("graph-io-small.bin", g, &names);
+  weighted_mapped_graph<int> m("graph-io-small.bin");
+  assert(same_adjacency(g, m) && m.num_edges() == 10);
+  assert(string(m.name(3)) == "x");
+  auto d = dag_shortest_paths(m, 1);
+  assert(d.dist[5] == 3); // s x y z
+  cout << "shortest paths from " << m.name(1) << ":";
+  for (int v = 0; v < m.num_vertices(); ++v)
+    if (d.reached(v))
+      cout << " " << m.name(v) << "=" << d.dist[v];
+  cout << "\n";
+
+  // the wrong weight type, a malformed line
+  bool thrown = false;
+  try {
+    weighted_mapped_graph<double> wrong("graph-io-small.bin");
+  } catch (const graph_format_error &) {
+    thrown = true;
+  }
+  assert(thrown);
+  {
+    ofstream text("graph-io-bad.txt");
+    text << "0 1\n1 x\n";
+  }
+  thrown = false;
+  try {
+    read_edge_list("graph-io-bad.txt", pool);
+  } catch (const graph_format_error &e) {
+    cout << e.what() << "\n";
+    thrown = true;
+  }
+  assert(thrown);
+
+  // weights that don't fit: in the type, in the copy of the field
+  auto rejects = [&](const string &line, bool as_double) {
+    {
+      ofstream text("graph-io-bad.txt");
+      text << line << "\n";
+    }
+    try {
+      if (as_double)
+        read_weighted_edge_list<double>("graph-io-bad.txt", one);
+      else
+        read_weighted_edge_list<int>("graph-io-bad.txt", one);
+    } catch (const graph_format_error &) {
+      return true;
+    }
+    return false;
+  };
+  assert(rejects("0 1 2147483648", false));
+  assert(rejects("0 1 -2147483649", false));
+  assert(rejects("0 1 99999999999999999999999", false));
+  assert(!rejects("0 1 -2147483648", false));
+  assert(rejects("0 1 1." + string(70, '0'), true));
+  assert(!rejects("0 1 1." + string(50, '0'), true));
+  {
+    ofstream text("graph-io-bad.txt");
+    text << "0 1 -9223372036854775808\n";
+  }
+  assert(read_weighted_edge_list<long long>("graph-io-bad.txt", one)
+             .edges[0]
+             .weight == numeric_limits<long long>::min());
+
+  // corrupted graph files: a copy of the small one with a field changed
+  auto corrupted = [&](size_t at, uint64_t value) {
+    ifstream in("graph-io-small.bin", ios::binary);
+    string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    memcpy(&bytes[at], &value, sizeof(value));
+    ofstream("graph-io-bad.bin", ios::binary) << bytes;
+    try {
+      mapped_graph bad("graph-io-bad.bin");
+    } catch (const graph_format_error &) {
+      return true;
+    }
+    return false;
+  };
+  const size_t offsets = sizeof(graph_file_header);
+  assert(!corrupted(offsets, 0));
+  // num_edges such that the sections wrap around to the size of the file
+  assert(corrupted(offsetof(graph_file_header, num_edges),
+                   uint64_t(1) << 62));
+  assert(corrupted(offsets, 1));                         // offsets[0]
+  assert(corrupted(offsets + 3 * sizeof(uint64_t), 1)); // decreasing
+  assert(corrupted(offsets + 6 * sizeof(uint64_t), 11)); // past the end
+  const size_t name_offsets = offsets + 7 * sizeof(uint64_t) +
+                              detail::align8(10 * sizeof(int32_t)) +
+                              detail::align8(10 * sizeof(int));
+  assert(!corrupted(name_offsets + 2 * sizeof(uint64_t), 4));
+  assert(corrupted(name_offsets + 2 * sizeof(uint64_t), 3)); // no '\0'
+  assert(corrupted(name_offsets + 6 * sizeof(uint64_t), 99));
+
+  // a bigger one: the same edge list whatever the number of threads, the
+  // same traversals on the mapped file as on the CSR graph
+  auto edges = with_random_weights<double>(rmat_edges(16, 8, 1), 0, 1, 2);
+  {
+    FILE *f = fopen("graph-io-rmat.txt", "w");
+    for (auto &e : edges)
+      fprintf(f, "%d %d %.17g\n", e.from, e.to, e.weight);
+    fclose(f);
+  }
+  stopwatch w;
+  auto parsed = read_weighted_edge_list<double>("graph-io-rmat.txt", pool);
+  double parse_time = w.seconds();
+  auto serial = read_weighted_edge_list<double>("graph-io-rmat.txt", one);
+  assert(parsed.edges.size() == edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    assert(parsed.edges[i].from == edges[i].from &&
+           parsed.edges[i].to == edges[i].to &&
+           parsed.edges[i].weight == edges[i].weight);
+    assert(serial.edges[i].weight == parsed.edges[i].weight);
+  }
+  weighted_csr_graph<double> big(parsed.num_vertices, parsed.edges);
+  write_graph("graph-io-rmat.bin", big);
+  w.restart();
+  weighted_mapped_graph<double> mapped("graph-io-rmat.bin");
+  double map_time = w.seconds();
+  assert(same_adjacency(big, mapped));
+  int s = 0;
+  for (int v = 0; v < big.num_vertices(); ++v)
+    if (big.degree(v) > big.degree(s))
+      s = v;
+  assert(bfs(mapped, s).dist == bfs(big, s).dist);
+  assert(dijkstra(mapped, s).dist == dijkstra(big, s).dist);
+  assert(tarjan_scc(mapped).count == tarjan_scc(big).count);
+  cout << edges.size() << " edges: parsed in " << parse_time
+       << "s, mapped in " << map_time << "s\n";
+
+  for (auto f : {"graph-io-small.txt", "graph-io-small.bin",
+                 "graph-io-bad.txt", "graph-io-bad.bin", "graph-io-rmat.txt",
+                 "graph-io-rmat.bin"})
+    remove(f);
+}
@@ -0,0 +1,479 @@
+// loading graphs from files
+//
+// Two formats:
+//
+// Text edge lists, one edge per line: "u v" or "u v w", the fields
+// separated by spaces, tabs or commas, lines starting with '#' or '%'
+// (SNAP and Matrix Market headers) and empty lines skipped.  The vertices
+// are the ints 0..max id.  read_edge_list maps the file and cuts it into
+// one chunk per thread (at line boundaries), the chunks are parsed side by
+// side into per-chunk edge vectors then concatenated in file order, so the
+// edge list is the same whatever the number of threads.  The numbers are
+// parsed by hand: no stream, no locale, no copy of the line.
+//
+// Binary graph files, a CSR graph (see csr.hpp) laid out so that it can be
+// used right where it's mapped:
+//
+//   header            64 bytes, see graph_file_header
+//   offsets           (n+1) x uint64
+//   targets           m x int32
+//   weights           m x W, if any
+//   name offsets      (n+1) x uint64, if any: the name of v starts at
+//                     names[name_offsets[v]]
+//   names             the names, each followed by a '\0'
+//
+// every section starting on an 8 byte boundary.  Numbers are in the byte
+// order of the machine that wrote the file, the header tells which.
+// mapped_graph maps the file and points into it: opening a graph that's in
+// the page cache costs a check of the offsets, and the pages of the
+// adjacency are only read when a traversal touches them.  mapped_graph
+// models the graph concept (num_vertices/neighbours) and
+// weighted_mapped_graph<W> adds out_edges, so bfs, dfs, scc, dijkstra...
+// run on them unchanged.
+#pragma once
+
+#include "../../util/mapped-file.hpp"
+#include "../../util/parallel.hpp"
+#include "csr.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+class graph_format_error : public std::runtime_error {
+public:
+  explicit graph_format_error(const string &what) : runtime_error(what) {}
+};
+
+// a parsed text edge list, num_vertices is the largest id + 1
+template <class Edge> class edge_list {
+public:
+  int num_vertices = 0;
+  vector<Edge> edges;
+};
+
+namespace detail {
+
+inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == ','; }
+
+// a non-negative int, p moves past it
+inline bool parse_id(const char *&p, const char *end, int &id) {
+  while (p < end && is_blank(*p))
+    ++p;
+  if (p == end || *p < '0' || *p > '9')
+    return false;
+  long long x = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    x = 10 * x + (*p++ - '0');
+    if (x > std::numeric_limits<int>::max())
+      return false;
+  }
+  id = static_cast<int>(x);
+  return true;
+}
+
+// the field [first, last) as an integer W by hand, false if it's not one
+// or doesn't fit in W
+template <class W>
+bool parse_number(const char *first, const char *last, W &w, std::true_type) {
+  using limits = std::numeric_limits<W>;
+  const char *q = first;
+  bool negative = *q == '-';
+  if (*q == '-' || *q == '+')
+    ++q;
+  if (q == last)
+    return false;
+  // the largest magnitude allowed, in unsigned so that -min fits
+  unsigned long long limit =
+      negative ? 0ULL - static_cast<unsigned long long>(
+                            static_cast<long long>(limits::min()))
+               : static_cast<unsigned long long>(limits::max());
+  unsigned long long x = 0;
+  for (; q < last; ++q) {
+    if (*q < '0' || *q > '9')
+      return false;
+    unsigned d = *q - '0';
+    if (x > (limit - d) / 10)
+      return false;
+    x = 10 * x + d;
+  }
+  w = negative && x > 0 ? static_cast<W>(-static_cast<long long>(x - 1) - 1)
+                        : static_cast<W>(x);
+  return true;
+}
+
+// floating point through strtod on a copy of the field (the file isn't
+// '\0' terminated), false for a field too long to copy
+template <class W>
+bool parse_number(const char *first, const char *last, W &w,
+                  std::false_type) {
+  char field[64];
+  size_t len = last - first;
+  if (len >= sizeof(field))
+    return false;
+  std::memcpy(field, first, len);
+  field[len] = '\0';
+  char *stop;
+  double x = std::strtod(field, &stop);
+  w = static_cast<W>(x);
+  return stop == field + len;
+}
+
+// a weight, p moves past it
+template <class W> bool parse_weight(const char *&p, const char *end, W &w) {
+  while (p < end && is_blank(*p))
+    ++p;
+  const char *first = p;
+  while (p < end && !is_blank(*p) && *p != '\n' && *p != '\r')
+    ++p;
+  if (first == p)
+    return false;
+  return parse_number(first, p, w, std::is_integral<W>());
+}
+
+// parses the lines starting in [first, last) of the text [begin, end),
+// add(p, end) parses one line from p and returns false if it's malformed
+template <class Add>
+void parse_lines(const char *first, const char *last, const char *end,
+                 Add add, string &error, const char *begin) {
+  const char *p = first;
+  while (p < last) {
+    const char *line = p;
+    while (p < end && is_blank(*p))
+      ++p;
+    if (p < end && *p != '\n' && *p != '\r' && *p != '#' && *p != '%' &&
+        !add(p, end)) {
+      error = "malformed edge at byte " + std::to_string(line - begin);
+      return;
+    }
+    // rest of the line
+    const char *nl = static_cast<const char *>(
+        std::memchr(p, '\n', static_cast<size_t>(end - p)));
+    p = nl ? nl + 1 : end;
+  }
+}
+
+inline int edge_source(const edge &e) { return e.first; }
+inline int edge_target(const edge &e) { return e.second; }
+template <class W> int edge_source(const weighted_edge<W> &e) {
+  return e.from;
+}
+template <class W> int edge_target(const weighted_edge<W> &e) { return e.to; }
+
+template <class Edge, class Add>
+edge_list<Edge> read_edge_list(const string &path, util::thread_pool &pool,
+                               Add add) {
+  util::mapped_file file(path);
+  file.will_read_sequentially();
+  const char *begin = file.data(), *end = begin + file.size();
+  const size_t chunks = pool.size();
+  // chunk c holds the lines starting in [bound[c], bound[c+1]), the bounds
+  // are pushed to the start of the next line
+  vector<const char *> bound(chunks + 1, end);
+  for (size_t c = 0; c < chunks; ++c) {
+    const char *p = begin + file.size() * c / chunks;
+    if (c > 0 && p > begin && p[-1] != '\n') {
+      auto nl = static_cast<const char *>(
+          std::memchr(p, '\n', static_cast<size_t>(end - p)));
+      p = nl ? nl + 1 : end;
+    }
+    bound[c] = p;
+  }
+  vector<vector<Edge>> local(chunks);
+  vector<string> errors(chunks);
+  vector<int> max_id(chunks, -1);
+  pool.run([&](int tid) {
+    parse_lines(bound[tid], bound[tid + 1], end,
+                [&](const char *&p, const char *e) {
+                  Edge edge;
+                  if (!add(p, e, edge))
+                    return false;
+                  max_id[tid] = std::max(
+                      max_id[tid], std::max(edge_source(edge),
+                                            edge_target(edge)));
+                  local[tid].push_back(edge);
+                  return true;
+                },
+                errors[tid], begin);
+  });
+  for (auto &e : errors)
+    if (!e.empty())
+      throw graph_format_error(path + ": " + e);
+  // concatenated in file order, each chunk copied by its own thread
+  edge_list<Edge> r;
+  vector<size_t> at(chunks + 1, 0);
+  for (size_t c = 0; c < chunks; ++c) {
+    at[c + 1] = at[c] + local[c].size();
+    r.num_vertices = std::max(r.num_vertices, max_id[c] + 1);
+  }
+  r.edges.resize(at[chunks]);
+  pool.run([&](int tid) {
+    std::copy(local[tid].begin(), local[tid].end(), r.edges.begin() + at[tid]);
+    vector<Edge>().swap(local[tid]);
+  });
+  return r;
+}
+}
+
+// "u v" lines, anything after v is ignored
+inline edge_list<edge> read_edge_list(const string &path,
+                                      util::thread_pool &pool) {
+  return detail::read_edge_list<edge>(
+      path, pool, [](const char *&p, const char *end, edge &e) {
+        return detail::parse_id(p, end, e.first) &&
+               detail::parse_id(p, end, e.second);
+      });
+}
+
+// "u v w" lines
+template <class W>
+edge_list<weighted_edge<W>> read_weighted_edge_list(const string &path,
+                                                    util::thread_pool &pool) {
+  return detail::read_edge_list<weighted_edge<W>>(
+      path, pool, [](const char *&p, const char *end, weighted_edge<W> &e) {
+        return detail::parse_id(p, end, e.from) &&
+               detail::parse_id(p, end, e.to) &&
+               detail::parse_weight(p, end, e.weight);
+      });
+}
+
+struct graph_file_header {
+  char magic[8];          // "CLRSCSR\0"
+  uint32_t version;       // 1
+  uint32_t byte_order;    // 0x01020304 as written by the writer
+  uint32_t weight_kind;   // 0: no weights, else weight_kind<W>()
+  uint32_t reserved0;
+  uint64_t num_vertices;
+  uint64_t num_edges;
+  uint64_t names_bytes;   // 0: no names
+  uint64_t reserved[2];
+};
+static_assert(sizeof(graph_file_header) == 64, "the header is 64 bytes");
+
+// floating point or signed or unsigned, and the size in bytes
+template <class W> uint32_t weight_kind() {
+  static_assert(std::is_arithmetic<W>::value, "weights are numbers");
+  return (std::is_floating_point<W>::value
+              ? 0x100
+              : std::is_signed<W>::value ? 0x200 : 0x300) |
+         static_cast<uint32_t>(sizeof(W));
+}
+
+namespace detail {
+
+inline size_t align8(size_t n) { return (n + 7) & ~size_t(7); }
+
+class file_writer {
+public:
+  explicit file_writer(const string &path)
+      : _path(path), _f(std::fopen(path.c_str(), "wb")) {
+    if (!_f)
+      throw std::runtime_error(path + ": can't open for writing");
+  }
+  ~file_writer() {
+    if (_f)
+      std::fclose(_f);
+  }
+  void write(const void *p, size_t bytes) {
+    if (bytes && std::fwrite(p, 1, bytes, _f) != bytes)
+      throw std::runtime_error(_path + ": write failed");
+    _at += bytes;
+  }
+  void pad() {
+    static const char zeros[8] = {};
+    write(zeros, align8(_at) - _at);
+  }
+  void close() {
+    if (std::fclose(_f) != 0) {
+      _f = nullptr;
+      throw std::runtime_error(_path + ": write failed");
+    }
+    _f = nullptr;
+  }
+
+private:
+  string _path;
+  std::FILE *_f;
+  size_t _at = 0;
+};
+
+inline void write_graph(const string &path, const csr_graph &g,
+                        uint32_t weight_kind, const void *weights,
+                        size_t weight_size, const vector<string> *names) {
+  const uint64_t n = g.num_vertices(), m = g.num_edges();
+  vector<uint64_t> name_offsets;
+  if (names) {
+    if (names->size() != n)
+      throw std::invalid_argument("one name per vertex");
+    name_offsets.push_back(0);
+    for (auto &s : *names)
+      name_offsets.push_back(name_offsets.back() + s.size() + 1);
+  }
+  graph_file_header h;
+  std::memset(&h, 0, sizeof(h));
+  std::memcpy(h.magic, "CLRSCSR", 8);
+  h.version = 1;
+  h.byte_order = 0x01020304;
+  h.weight_kind = weight_kind;
+  h.num_vertices = n;
+  h.num_edges = m;
+  h.names_bytes = names ? name_offsets.back() : 0;
+
+  file_writer out(path);
+  out.write(&h, sizeof(h));
+  vector<uint64_t> offsets(g.offsets.begin(), g.offsets.end());
+  out.write(offsets.data(), offsets.size() * sizeof(uint64_t));
+  vector<int32_t> targets(g.targets.begin(), g.targets.end());
+  out.write(targets.data(), targets.size() * sizeof(int32_t));
+  out.pad();
+  if (weight_kind) {
+    out.write(weights, m * weight_size);
+    out.pad();
+  }
+  if (names) {
+    out.write(name_offsets.data(), name_offsets.size() * sizeof(uint64_t));
+    for (auto &s : *names)
+      out.write(s.c_str(), s.size() + 1);
+    out.pad();
+  }
+  out.close();
+}
+}
+
+// names: one per vertex, or none
+inline void write_graph(const string &path, const csr_graph &g,
+                        const vector<string> *names = nullptr) {
+  detail::write_graph(path, g, 0, nullptr, 0, names);
+}
+
+template <class W>
+void write_graph(const string &path, const weighted_csr_graph<W> &g,
+                 const vector<string> *names = nullptr) {
+  detail::write_graph(path, g, weight_kind<W>(), g.weights.data(), sizeof(W),
+                      names);
+}
+
+// A graph file mapped in memory, the arrays point into the mapping.
+// Throws graph_format_error if the file isn't a graph file of this machine.
+class mapped_graph {
+public:
+  explicit mapped_graph(const string &path) : _file(path) {
+    const char *base = _file.data();
+    if (_file.size() < sizeof(graph_file_header))
+      throw graph_format_error(path + ": not a graph file");
+    std::memcpy(&_header, base, sizeof(_header));
+    if (std::memcmp(_header.magic, "CLRSCSR", 8) != 0 ||
+        _header.version != 1)
+      throw graph_format_error(path + ": not a graph file");
+    if (_header.byte_order != 0x01020304)
+      throw graph_format_error(path + ": written with another byte order");
+    const uint64_t n = _header.num_vertices, m = _header.num_edges;
+    const uint64_t size = _file.size();
+    const string corrupted = path + ": truncated or corrupted graph file";
+    // each edge takes 4 bytes of the file at least, each name 1: bounding
+    // the counts by the size first keeps the sums below from overflowing
+    if (n > uint64_t(std::numeric_limits<int>::max()) || m > size / 4 ||
+        _header.names_bytes > size)
+      throw graph_format_error(corrupted);
+    size_t at = sizeof(graph_file_header);
+    _offsets = reinterpret_cast<const uint64_t *>(base + at);
+    at += (n + 1) * sizeof(uint64_t);
+    _targets = reinterpret_cast<const int32_t *>(base + at);
+    at = detail::align8(at + m * sizeof(int32_t));
+    if (_header.weight_kind) {
+      _weights = base + at;
+      at = detail::align8(at + m * (_header.weight_kind & 0xff));
+    }
+    if (_header.names_bytes) {
+      _name_offsets = reinterpret_cast<const uint64_t *>(base + at);
+      at += (n + 1) * sizeof(uint64_t);
+      _names = base + at;
+      at = detail::align8(at + _header.names_bytes);
+    }
+    if (at != size)
+      throw graph_format_error(corrupted);
+    // The offsets, O(V): the lists have to stay within the targets.  The
+    // targets themselves aren't read, that would read the whole file.
+    if (_offsets[0] != 0 || _offsets[n] != m)
+      throw graph_format_error(corrupted);
+    for (uint64_t u = 0; u < n; ++u)
+      if (_offsets[u + 1] < _offsets[u])
+        throw graph_format_error(corrupted);
+    // each name ends with its '\0'
+    if (_names) {
+      if (_name_offsets[0] != 0 || _name_offsets[n] != _header.names_bytes)
+        throw graph_format_error(corrupted);
+      for (uint64_t v = 0; v < n; ++v)
+        if (_name_offsets[v + 1] <= _name_offsets[v] ||
+            _names[_name_offsets[v + 1] - 1] != '\0')
+          throw graph_format_error(corrupted);
+    }
+  }
+
+  int num_vertices() const { return static_cast<int>(_header.num_vertices); }
+  size_t num_edges() const { return _header.num_edges; }
+  size_t degree(int u) const { return _offsets[u + 1] - _offsets[u]; }
+  bool has_names() const { return _names != nullptr; }
+  // nullptr without names
+  const char *name(int v) const {
+    return _names ? _names + _name_offsets[v] : nullptr;
+  }
+
+  const uint64_t *offsets() const { return _offsets; }
+  const int32_t *targets() const { return _targets; }
+
+protected:
+  graph_file_header _header;
+  util::mapped_file _file;
+  const uint64_t *_offsets = nullptr;
+  const int32_t *_targets = nullptr;
+  const char *_weights = nullptr;
+  const uint64_t *_name_offsets = nullptr;
+  const char *_names = nullptr;
+};
+
+// the same with out_edges, W has to be the type of the weights in the file
+template <class W> class weighted_mapped_graph : public mapped_graph {
+public:
+  using weight_type = W;
+
+  explicit weighted_mapped_graph(const string &path) : mapped_graph(path) {
+    if (_header.weight_kind != weight_kind<W>())
+      throw graph_format_error(path + ": no weights of this type");
+  }
+
+  const W *weights() const { return reinterpret_cast<const W *>(_weights); }
+};
+
+inline int num_vertices(const mapped_graph &g) { return g.num_vertices(); }
+
+inline range<const int *> neighbours(const mapped_graph &g, int u) {
+  static_assert(sizeof(int) == sizeof(int32_t), "int is 32 bits");
+  auto base = reinterpret_cast<const int *>(g.targets());
+  return range<const int *>(base + g.offsets()[u], base + g.offsets()[u + 1]);
+}
+
+template <class W>
+range<arc_iterator<W>> out_edges(const weighted_mapped_graph<W> &g, int u) {
+  auto first = g.offsets()[u], last = g.offsets()[u + 1];
+  auto targets = reinterpret_cast<const int *>(g.targets());
+  return range<arc_iterator<W>>(
+      arc_iterator<W>(targets + first, g.weights() + first),
+      arc_iterator<W>(targets + last, g.weights() + last));
+}
+}
+}
@@ -1,9 +1,20 @@
 // an adjacency list representation of graph
 //
+// The traversal algorithms in this directory don't touch fixed_graph
+// directly, they're written against a tiny "graph concept" made of two free
+// functions, so that any representation providing them can be traversed:
+//
+//   num_vertices(g)   -> int, vertices are the dense ids 0..num_vertices(g)-1
+//   neighbours(g, u)  -> a range (begin()/end()) of the int ids of the
+//                        out-neighbours of u
+//
+// fixed_graph below and csr_graph in csr.hpp both model it.
+#pragma once
 
 #include <array>
 #include <cassert>
 #include <iostream>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -24,32 +35,13 @@ public:
   node *prev;
 };
 
-class dfs_node : public node {
-
-public:
-  explicit dfs_node(int id) : node(id), discovery_time(0), finish_time(0) {}
-  dfs_node() : discovery_time(0), finish_time(0) {}
-  virtual ~dfs_node() {}
-  int discovery_time;
-  int finish_time;
-};
-
-ostream &operator<<(ostream &stream, const node &n) {
+inline ostream &operator<<(ostream &stream, const node &n) {
   stream << "id: " << n.id << ", dist: " << n.dist << ", prev: ";
   if (n.prev)
     stream << n.prev->id;
   else
     stream << "null";
-}
-
-ostream &operator<<(ostream &stream, const dfs_node &n) {
-  stream << "id: " << n.id << ", dist: " << n.dist
-         << ", dtime: " << n.discovery_time
-         << ", finish time: " << n.finish_time << ", prev: ";
-  if (n.prev)
-    stream << n.prev->id;
-  else
-    stream << "null";
+  return stream;
 }
 
 template <class T> class adjacency_list {
@@ -68,6 +60,7 @@ ostream &operator<<(ostream &stream, const adjacency_list<T> &l) {
     stream << "(" << t << ")--> ";
   }
   stream << " ]";
+  return stream;
 }
 
 template <class T, int V> class fixed_graph {
@@ -76,10 +69,8 @@ public:
   ~fixed_graph() {}
   void add(T &&u, T &&v) {
     assert(u.id < V);
-    if (graph[u.id].adj_list.empty()) {
-      graph[u.id].head.id = u.id;
-      graph[u.id].head.dist = u.dist;
-    }
+    if (graph[u.id].adj_list.empty())
+      graph[u.id].head = u;
     graph[u.id].adj_list.push_back(forward<T>(v));
   }
 
@@ -91,13 +82,66 @@ ostream &operator<<(ostream &stream, const fixed_graph<T, V> &g) {
   for (auto &l : g.graph) {
     stream << l << "\n";
   }
+  return stream;
 }
 
-void set_visited(vector<bool> &visited, int i) {
-  // cout << "node " << i << " is now visited\n";
-  visited[i] = true;
+// A pair of iterators that can be used in a range-for, this is what
+// neighbours() hands out.
+template <class It> class range {
+public:
+  range(It first, It last) : _first(first), _last(last) {}
+  It begin() const { return _first; }
+  It end() const { return _last; }
+  size_t size() const { return distance(_first, _last); }
+  bool empty() const { return _first == _last; }
+
+private:
+  It _first;
+  It _last;
+};
+
+// Walks a vector<T> of nodes but only yields their ids, so that the
+// algorithms never see (or copy) the node objects stored in adj_list.
+template <class It> class id_iterator {
+public:
+  using iterator_category = forward_iterator_tag;
+  using value_type = int;
+  using difference_type = ptrdiff_t;
+  using pointer = const int *;
+  using reference = int;
+
+  id_iterator() {}
+  explicit id_iterator(It it) : _it(it) {}
+  int operator*() const { return _it->id; }
+  id_iterator &operator++() {
+    ++_it;
+    return *this;
+  }
+  id_iterator operator++(int) {
+    auto old = *this;
+    ++_it;
+    return old;
+  }
+  bool operator==(const id_iterator &other) const { return _it == other._it; }
+  bool operator!=(const id_iterator &other) const { return _it != other._it; }
+
+private:
+  It _it;
+};
+
+template <class T, int V> int num_vertices(const fixed_graph<T, V> &) {
+  return V;
+}
+
+template <class T, int V>
+decltype(auto) neighbours(const fixed_graph<T, V> &g, int u) {
+  using it = id_iterator<typename vector<T>::const_iterator>;
+  auto &l = g.graph[u].adj_list;
+  return range<it>(it(l.begin()), it(l.end()));
 }
 
+inline void set_visited(vector<bool> &visited, int i) { visited[i] = true; }
+
 template <class T, int V> void dump_graph(fixed_graph<T, V> &g) {
   cout << "--------------------\n";
   cout << g;
@@ -0,0 +1,102 @@
+// named graph benchmark: building a graph by name
+//
+// g++ named-graph-bench.cpp -std=c++14 -O2 -pthread
+// ./a.out [scale=20]
+//
+// 2^scale package names of 20 to 40 characters and 4 * 2^scale dependency
+// edges between them (R-MAT, so some names are in a lot of edges), given
+// as pairs of names.  The graph is built three ways:
+//   interned     named_graph_builder: the names interned, a csr_graph of ids
+//   std::string  the usual index: an unordered_map<string, int> and a
+//                vector<string> of the names, a csr_graph of ids
+//   topo_node    a node per edge as fixed_graph<topo_node> stores them, a
+//                vector of topo_node per vertex (ids from the same map)
+// For each, the time and the growth of the peak resident memory (they run
+// from the smallest to the biggest so that each one pushes the peak).
+
+#include "../../util/bench.hpp"
+#include "csr.hpp"
+#include "generators.hpp"
+#include "named-graph.hpp"
+#include "toposort.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+template <class F> void measure(const char *how, F &&build) {
+  size_t before = peak_memory_bytes();
+  stopwatch w;
+  size_t vertices = build();
+  double t = w.seconds();
+  printf("%-12s %10.3f %12.1f %10zu\n", how, t,
+         (peak_memory_bytes() - before) / 1048576.0, vertices);
+}
+
+int main(int argc, char **argv) {
+  int scale = argc > 1 ? atoi(argv[1]) : 20;
+  const int n = 1 << scale;
+  mt19937 rng(1);
+  vector<string> names(n);
+  for (auto &s : names) {
+    s = "org.example.";
+    for (int len = 8 + rng() % 21; len > 0; --len)
+      s += char('a' + rng() % 26);
+  }
+  auto edges = rmat_edges(scale, 4, 2);
+  printf("names: %d, edges: %zu\n", n, edges.size());
+  printf("%-12s %10s %12s %10s\n", "build", "seconds", "peak +MB", "vertices");
+
+  named_graph g;
+  measure("interned", [&] {
+    named_graph_builder b;
+    for (auto &e : edges)
+      b.add_edge(names[e.first], names[e.second]);
+    g = b.build();
+    return size_t(g.num_vertices());
+  });
+
+  measure("std::string", [&] {
+    unordered_map<string, int> index;
+    vector<string> by_id;
+    auto id = [&](const string &s) {
+      auto it = index.emplace(s, static_cast<int>(by_id.size()));
+      if (it.second)
+        by_id.push_back(s);
+      return it.first->second;
+    };
+    vector<edge> ids;
+    for (auto &e : edges) {
+      int u = id(names[e.first]);
+      ids.emplace_back(u, id(names[e.second]));
+    }
+    csr_graph cg(static_cast<int>(by_id.size()), ids);
+    assert(cg.num_edges() == g.num_edges());
+    return by_id.size();
+  });
+
+  measure("topo_node", [&] {
+    unordered_map<string, int> index;
+    vector<vector<topo_node>> adj;
+    auto id = [&](const string &s) {
+      auto it = index.emplace(s, static_cast<int>(adj.size()));
+      if (it.second)
+        adj.emplace_back();
+      return it.first->second;
+    };
+    for (auto &e : edges) {
+      int u = id(names[e.first]), v = id(names[e.second]);
+      adj[u].push_back(topo_node(v, names[e.second]));
+    }
+    return adj.size();
+  });
+  printf("interner: %.1f MB for %d names\n",
+         g.names().memory_bytes() / 1048576.0, g.num_vertices());
+}
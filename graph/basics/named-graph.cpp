@@ -0,0 +1,78 @@
+// named graphs, see named-graph.hpp
+//
+// g++ named-graph.cpp -std=c++14 -pthread
+
+#include "../../util/string-interner.hpp"
+#include "named-graph.hpp"
+#include "scc.hpp"
+#include "toposort.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+int main() {
+  // each string once, ids in order of first appearance, the copies stay
+  // put while the table grows and the arena fills more blocks
+  string_interner names(64);
+  vector<const char *> first;
+  for (int i = 0; i < 10000; ++i) {
+    assert(names.intern("package-" + to_string(i)) == i);
+    first.push_back(names.c_str(i));
+  }
+  string big(1000, 'x'); // bigger than a block
+  int b = names.intern(big);
+  assert(names.intern(big) == b && names.str(b) == big);
+  for (int i = 0; i < 10000; ++i) {
+    assert(names.intern("package-" + to_string(i)) == i);
+    assert(names.c_str(i) == first[i]);
+    assert(names.find("package-" + to_string(i)) == i);
+  }
+  assert(names.find("package-10000") == -1 && names.size() == 10001);
+  assert(names.intern("", 0) == 10001 && names.length(10001) == 0);
+  assert(strcmp(names.c_str(7), "package-7") == 0);
+
+  // a dependency file, read by name
+  string path = "/tmp/named-graph-demo.txt";
+  {
+    ofstream out(path);
+    out << "# package dependency\n"
+           "app libui\n"
+           "app libnet\n"
+           "libui libcore\n"
+           "libnet libcore\n"
+           "libnet,libssl\n"
+           "libssl\tlibcore\n"
+           "\n"
+           "tests app\n";
+  }
+  auto g = read_named_edge_list(path);
+  assert(g.num_vertices() == 6 && g.num_edges() == 7);
+  assert(g.id("app") == 0 && g.id("libcore") == 3 && g.id("nope") == -1);
+  // the dependencies first: reverse topological order
+  auto order = topological_sort(g);
+  for (auto it = order.rbegin(); it != order.rend(); ++it)
+    cout << g.name(*it) << " ";
+  cout << "\n";
+  assert(strcmp(g.name(order.back()), "libcore") == 0);
+  assert(tarjan_scc(g).count == 6);
+
+  {
+    ofstream out(path);
+    out << "app libui\nlonely\n";
+  }
+  try {
+    read_named_edge_list(path);
+    assert(false);
+  } catch (const graph_format_error &e) {
+    cout << e.what() << "\n";
+  }
+  remove(path.c_str());
+}
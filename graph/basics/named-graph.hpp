@@ -0,0 +1,145 @@
+// graphs whose vertices have names
+//
+// topo_node (toposort.hpp) carries its name as a std::string, and
+// fixed_graph::add stores a whole node per edge: every edge copies the name
+// of its target, a heap allocation for anything longer than the small
+// string buffer.  On a dependency graph with millions of named packages
+// that's most of the loading time and of the memory.
+//
+// Here the names are interned (util/string-interner.hpp): each is stored
+// once in an arena and known by its id, the dense vertex id.  The builder
+// turns names into ids as the edges come, the graph itself is a csr_graph
+// of ids, and the algorithms only ever see ints.  The names come back at
+// output: name(v).
+//
+//   named_graph_builder b;
+//   b.add_edge("pants", "shoes");     // the ids 0 and 1
+//   auto g = b.build();
+//   for (int v : topological_sort(g)) cout << g.name(v);
+//
+// read_named_edge_list loads "from to" lines of names straight from a
+// file, through the builder.
+#pragma once
+
+#include "../../util/mapped-file.hpp"
+#include "../../util/string-interner.hpp"
+#include "csr.hpp"
+#include "graph-io.hpp"
+#include "graph.hpp"
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+class named_graph {
+public:
+  named_graph() {}
+
+  int num_vertices() const { return _g.num_vertices(); }
+  size_t num_edges() const { return _g.num_edges(); }
+  size_t degree(int u) const { return _g.degree(u); }
+
+  const char *name(int v) const { return _names.c_str(v); }
+  // the id of a name, -1 if there's no such vertex
+  int id(const string &name) const { return _names.find(name); }
+
+  const csr_graph &graph() const { return _g; }
+  const util::string_interner &names() const { return _names; }
+
+private:
+  friend class named_graph_builder;
+  named_graph(util::string_interner names, csr_graph g)
+      : _names(std::move(names)), _g(std::move(g)) {}
+
+  util::string_interner _names;
+  csr_graph _g;
+};
+
+inline int num_vertices(const named_graph &g) { return g.num_vertices(); }
+
+inline range<const int *> neighbours(const named_graph &g, int u) {
+  return neighbours(g.graph(), u);
+}
+
+class named_graph_builder {
+public:
+  // the id of the vertex, a new one the first time the name is seen
+  int add_vertex(const char *name, size_t length) {
+    return _names.intern(name, length);
+  }
+  int add_vertex(const string &name) { return _names.intern(name); }
+
+  void add_edge(int u, int v) { _edges.emplace_back(u, v); }
+  void add_edge(const string &from, const string &to) {
+    int u = add_vertex(from);
+    _edges.emplace_back(u, add_vertex(to));
+  }
+
+  int num_vertices() const { return _names.size(); }
+  void reserve(size_t vertices, size_t edges) {
+    _names.reserve(vertices);
+    _edges.reserve(edges);
+  }
+
+  // the builder is left empty
+  named_graph build() {
+    csr_graph g(_names.size(), _edges);
+    vector<edge>().swap(_edges);
+    util::string_interner names;
+    std::swap(names, _names);
+    return named_graph(std::move(names), std::move(g));
+  }
+
+private:
+  util::string_interner _names;
+  vector<edge> _edges;
+};
+
+namespace detail {
+
+// a name: anything up to a blank or the end of the line
+inline bool parse_name(const char *&p, const char *end, const char *&name,
+                       size_t &length) {
+  while (p < end && is_blank(*p))
+    ++p;
+  name = p;
+  while (p < end && !is_blank(*p) && *p != '\n' && *p != '\r')
+    ++p;
+  length = static_cast<size_t>(p - name);
+  return length > 0;
+}
+}
+
+// "from to" lines, '#' and '%' comments as in read_edge_list.  The ids are
+// given in order of first appearance.  Throws graph_format_error.
+inline named_graph read_named_edge_list(const string &path) {
+  util::mapped_file file(path);
+  file.will_read_sequentially();
+  const char *begin = file.data(), *end = begin + file.size();
+  named_graph_builder b;
+  string error;
+  detail::parse_lines(begin, end, end,
+                      [&](const char *&p, const char *e) {
+                        const char *from, *to;
+                        size_t from_length, to_length;
+                        if (!detail::parse_name(p, e, from, from_length) ||
+                            !detail::parse_name(p, e, to, to_length))
+                          return false;
+                        int u = b.add_vertex(from, from_length);
+                        b.add_edge(u, b.add_vertex(to, to_length));
+                        return true;
+                      },
+                      error, begin);
+  if (!error.empty())
+    throw graph_format_error(path + ": " + error);
+  return b.build();
+}
+}
+}
@@ -0,0 +1,107 @@
+// traversal observers
+//
+// The traversals (dfs_visit/dfs, bfs, dijkstra) take an observer, a
+// compile-time policy whose member functions are called at the interesting
+// points of the algorithm:
+//
+//   discover_vertex(v)         v seen for the first time (pushed on the dfs
+//                              stack, enqueued by bfs, first queued by
+//                              dijkstra)
+//   finish_vertex(v)           dfs: v's adjacency is done, dijkstra: v's
+//                              distance is final
+//   examine_edge(u, v)         the edge u -> v is looked at
+//   begin_level(depth, size)   bfs starts the vertices at distance depth,
+//                              size of them (only if levels is true)
+//   stack_depth(d)             the dfs stack is now d frames deep
+//   heap_push(v), heap_decrease(v), heap_pop(v)
+//                              dijkstra's priority queue operations
+//
+// null_observer does nothing: with it (the default) every call is an empty
+// inline function and the traversal compiles to what it was without any
+// instrumentation.  To watch only a few events derive from null_observer
+// and hide the functions needed.  levels is a compile-time switch for the
+// bookkeeping bfs needs to detect the levels.
+//
+// counting_observer counts, trace_observer records every event in order.
+// The observer is taken by reference, it's read after the traversal.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+struct null_observer {
+  static const bool levels = false;
+  void discover_vertex(int) {}
+  void finish_vertex(int) {}
+  void examine_edge(int, int) {}
+  void begin_level(int, std::size_t) {}
+  void stack_depth(std::size_t) {}
+  void heap_push(int) {}
+  void heap_decrease(int) {}
+  void heap_pop(int) {}
+};
+
+class counting_observer : public null_observer {
+public:
+  static const bool levels = true;
+  void discover_vertex(int) { ++discovered; }
+  void finish_vertex(int) { ++finished; }
+  void examine_edge(int, int) { ++edges_examined; }
+  void begin_level(int, std::size_t size) { frontier_sizes.push_back(size); }
+  void stack_depth(std::size_t d) {
+    max_stack_depth = std::max(max_stack_depth, d);
+  }
+  void heap_push(int) { ++pushes; }
+  void heap_decrease(int) { ++decreases; }
+  void heap_pop(int) { ++pops; }
+
+  std::size_t discovered = 0, finished = 0, edges_examined = 0;
+  std::size_t max_stack_depth = 0;
+  std::vector<std::size_t> frontier_sizes; // bfs, one per level
+  std::size_t pushes = 0, decreases = 0, pops = 0;
+};
+
+class trace_observer : public null_observer {
+public:
+  enum kind { discover, finish, examine, level, push, decrease, pop };
+  // examine: the edge u -> v, level: depth u and size v, the others: u
+  struct event {
+    kind what;
+    int u;
+    long long v;
+  };
+
+  static const bool levels = true;
+  void discover_vertex(int v) { events.push_back(event{discover, v, -1}); }
+  void finish_vertex(int v) { events.push_back(event{finish, v, -1}); }
+  void examine_edge(int u, int v) { events.push_back(event{examine, u, v}); }
+  void begin_level(int depth, std::size_t size) {
+    events.push_back(event{level, depth, static_cast<long long>(size)});
+  }
+  void heap_push(int v) { events.push_back(event{push, v, -1}); }
+  void heap_decrease(int v) { events.push_back(event{decrease, v, -1}); }
+  void heap_pop(int v) { events.push_back(event{pop, v, -1}); }
+
+  // one event per line
+  void print(std::ostream &out) const {
+    static const char *names[] = {"discover", "finish",   "examine", "level",
+                                  "push",     "decrease", "pop"};
+    for (auto &e : events) {
+      out << names[e.what] << " " << e.u;
+      if (e.what == examine)
+        out << " -> " << e.v;
+      else if (e.what == level)
+        out << " (" << e.v << " vertices)";
+      out << "\n";
+    }
+  }
+
+  std::vector<event> events;
+};
+}
+}
@@ -0,0 +1,98 @@
+// reachability benchmark: the index against a dfs per query
+//
+// g++ reachability-bench.cpp -std=c++14 -O2 -pthread
+// ./a.out [scale=16] [max threads=hardware threads]
+//
+// The inputs: a directed R-MAT graph with 2^scale vertices and 4 * 2^scale
+// edges (a giant component, a small condensation) and a random DAG with as
+// many (every vertex its own component).  For each method of the index
+// (transitive closure when it fits in 1 GB, 2-hop labels) the build time,
+// the size and the queries per second, then the batch on 1..N threads.
+
+#include "../../util/bench.hpp"
+#include "../../util/parallel.hpp"
+#include "csr.hpp"
+#include "dfs.hpp"
+#include "generators.hpp"
+#include "reachability.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+void run(const string &name, const csr_graph &g, int max_threads) {
+  const int n = g.num_vertices();
+  mt19937 rng(1);
+  vector<pair<int, int>> queries;
+  for (int q = 0; q < 1000000; ++q)
+    queries.emplace_back(rng() % n, rng() % n);
+  printf("\n%s: vertices: %d, edges: %zu\n", name.c_str(), n, g.num_edges());
+
+  // a dfs from u for a few of the queries, it's slow
+  const size_t few = 50;
+  vector<char> expected(few);
+  double t_dfs = best_time(1, [&] {
+    for (size_t q = 0; q < few; ++q) {
+      dfs_result r(n);
+      dfs_visit(g, queries[q].first, r);
+      expected[q] = r.discovered(queries[q].second);
+    }
+  });
+  printf("%-20s %12s %12s %12s %12s\n", "method", "build s", "MB",
+         "hubs", "queries/s");
+  printf("%-20s %12s %12s %12s %12.1f\n", "dfs per query", "-", "-", "-",
+         few / t_dfs);
+
+  const size_t closure_max = size_t(1) << 30;
+  bool first = true;
+  for (size_t budget : {closure_max, size_t(0)}) {
+    reachability_index index;
+    double t_build =
+        best_time(1, [&] { index = reachability_index(g, budget); });
+    if (budget > 0 && index.method() != reachability_index::transitive_closure)
+      continue; // doesn't fit
+    for (size_t q = 0; q < few; ++q)
+      assert(index.reachable(queries[q].first, queries[q].second) ==
+             bool(expected[q]));
+    size_t yes = 0;
+    double t_query = best_time(3, [&] {
+      yes = 0;
+      for (auto &q : queries)
+        yes += index.reachable(q.first, q.second);
+    });
+    bool closure = index.method() == reachability_index::transitive_closure;
+    printf("%-20s %12.3f %12.1f %12zu %12.0f\n",
+           closure ? "transitive closure" : "2-hop", t_build,
+           index.size_in_bytes() / 1048576.0, index.label_entries(),
+           queries.size() / t_query);
+    if (first)
+      printf("  %d components, %.1f%% of the queries reachable\n",
+             index.num_components(), 100.0 * yes / queries.size());
+    first = false;
+
+    vector<int> counts;
+    for (int threads = 1; threads < max_threads; threads *= 2)
+      counts.push_back(threads);
+    counts.push_back(max_threads);
+    for (int threads : counts) {
+      thread_pool pool(threads);
+      double t = best_time(3, [&] { index.reachable(queries, &pool); });
+      printf("  batch, %-11d %51.0f\n", threads, queries.size() / t);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  int scale = argc > 1 ? atoi(argv[1]) : 16;
+  int max_threads = argc > 2 ? atoi(argv[2]) : hardware_threads();
+  int n = 1 << scale;
+  run("rmat", csr_graph(n, rmat_edges(scale, 4, 1)), max_threads);
+  run("dag", csr_graph(n, random_dag_edges(n, 4LL * n, 1)), max_threads);
+}
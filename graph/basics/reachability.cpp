@@ -0,0 +1,75 @@
+// reachability index, see reachability.hpp
+//
+// g++ reachability.cpp -std=c++14 -pthread
+
+#include "../../util/parallel.hpp"
+#include "csr.hpp"
+#include "dfs.hpp"
+#include "generators.hpp"
+#include "reachability.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+// the answers of a dfs per source
+vector<vector<char>> reach_by_dfs(const csr_graph &g) {
+  const int n = g.num_vertices();
+  vector<vector<char>> reach(n);
+  for (int u = 0; u < n; ++u) {
+    dfs_result r(n);
+    dfs_visit(g, u, r);
+    reach[u].resize(n);
+    for (int v = 0; v < n; ++v)
+      reach[u][v] = r.discovered(v);
+  }
+  return reach;
+}
+
+int main() {
+  // CLRS P.616 Figure 22.9: {a, b, e} -> {c, d}, {f, g} -> {h}
+  //                          a  b  c  d  e  f  g  h
+  csr_graph fig(8, {{0, 1}, {1, 2}, {1, 4}, {1, 5}, {2, 3}, {2, 6}, {3, 2},
+                    {3, 7}, {4, 0}, {4, 5}, {5, 6}, {6, 5}, {6, 7}, {7, 7}});
+  for (size_t budget : {reachability_index::default_closure_budget,
+                        size_t(0)}) {
+    reachability_index index(fig, budget);
+    assert(index.num_components() == 4);
+    assert(index.reachable(4, 1) && index.reachable(0, 7));
+    assert(index.reachable(2, 6) && !index.reachable(6, 2));
+    assert(!index.reachable(7, 0) && index.reachable(7, 7));
+  }
+
+  // random graphs, both methods against a dfs per source
+  mt19937 rng(5);
+  for (int round = 0; round < 4; ++round) {
+    const int n = 400;
+    // sparse enough to keep many components
+    csr_graph g(n, erdos_renyi_edges(n, n + round * n / 4, rng()));
+    auto expected = reach_by_dfs(g);
+    reachability_index closure(g), labels(g, 0);
+    assert(closure.method() == reachability_index::transitive_closure);
+    assert(labels.method() == reachability_index::two_hop);
+    vector<pair<int, int>> queries;
+    for (int u = 0; u < n; ++u)
+      for (int v = 0; v < n; ++v) {
+        assert(closure.reachable(u, v) == bool(expected[u][v]));
+        assert(labels.reachable(u, v) == bool(expected[u][v]));
+        queries.emplace_back(u, v);
+      }
+    thread_pool pool(3);
+    auto batch = labels.reachable(queries, &pool);
+    for (size_t q = 0; q < queries.size(); ++q)
+      assert(batch[q] == expected[queries[q].first][queries[q].second]);
+    cout << n << " vertices, " << g.num_edges() << " edges: "
+         << closure.num_components() << " components, closure "
+         << closure.size_in_bytes() << " bytes, 2-hop "
+         << labels.size_in_bytes() << " bytes (" << labels.label_entries()
+         << " hubs)\n";
+  }
+}
@@ -0,0 +1,235 @@
+// reachability index: "can u reach v" in (nearly) constant time
+//
+// A dfs per query costs O(V + E).  When the same graph is asked many
+// questions, it pays to index it once:
+//
+// 1. The strongly connected components (tarjan_scc): inside a component
+//    everything reaches everything, so the questions are asked about the
+//    condensation, a DAG, instead.  Tarjan numbers the components in reverse
+//    topological order, an edge of the condensation goes from c to some
+//    d < c.
+// 2. Two filters answer most queries without looking further:
+//     - topological: c can't reach d > c,
+//     - dfs intervals: a dfs of the condensation from its sources gives
+//       each component its discovery and finish times (dfs_result::d, f);
+//       d is a descendant of c in the dfs forest, so reachable, when its
+//       interval is nested in the interval of c.
+// 3. The rest is answered exactly, by one of:
+//     - the transitive closure, a bitset per component of the components it
+//       reaches.  Built sinks first, each row being the OR of the rows of
+//       the successors (64 components per word operation).  count^2 bits:
+//       for small condensations, the query is a bit test.
+//     - 2-hop labels (pruned landmark labeling, Yano et al.): each
+//       component c gets a list out(c) of "hub" components it reaches and a
+//       list in(c) of hubs reaching it, such that c reaches d iff out(c)
+//       and in(d) share a hub.  The hubs are taken by decreasing (in-degree
+//       + 1) * (out-degree + 1); from each hub h, a forward bfs adds h to
+//       in(w) of the components w it reaches, and a backward one adds h to
+//       out(w), but a search stops at any w for which the labels already
+//       answer the question.  On real graphs the lists stay short (a few
+//       hubs) and the query is a merge of two small sorted lists.
+//    The closure is used when it fits in closure_budget bytes.
+//
+// reachable(queries, pool) answers a batch on a thread pool, the index is
+// only read.
+#pragma once
+
+#include "../../util/parallel.hpp"
+#include "csr.hpp"
+#include "dfs.hpp"
+#include "graph.hpp"
+#include "scc.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::size_t;
+using std::uint64_t;
+using std::vector;
+
+class reachability_index {
+public:
+  enum kind { transitive_closure, two_hop };
+  static const size_t default_closure_budget = size_t(64) << 20;
+
+  reachability_index() {}
+  template <class G>
+  explicit reachability_index(const G &g,
+                              size_t closure_budget = default_closure_budget) {
+    auto scc = tarjan_scc(g);
+    _component = std::move(scc.component);
+    _count = scc.count;
+    const auto &dag = scc.condensation;
+    // the dfs forest from the sources: the components by decreasing id
+    dfs_result r(_count);
+    for (int c = _count; c-- > 0;)
+      if (!r.discovered(c))
+        dfs_visit(dag, c, r);
+    _d = std::move(r.d);
+    _f = std::move(r.f);
+    _words = (static_cast<size_t>(_count) + 63) / 64;
+    if (_words * _count * sizeof(uint64_t) <= closure_budget)
+      build_closure(dag);
+    else
+      build_two_hop(dag);
+  }
+
+  kind method() const { return _kind; }
+  int num_vertices() const { return static_cast<int>(_component.size()); }
+  int num_components() const { return _count; }
+  int component(int v) const { return _component[v]; }
+
+  bool reachable(int u, int v) const {
+    int c = _component[u], d = _component[v];
+    if (c == d)
+      return true;
+    if (c < d)
+      return false;
+    if (_d[c] < _d[d] && _f[d] < _f[c])
+      return true;
+    if (_kind == transitive_closure)
+      return (_closure[c * _words + (d >> 6)] >> (d & 63)) & 1;
+    return share_hub(c, d);
+  }
+
+  // the answers to the (u, v) queries, 1 if u reaches v
+  vector<char> reachable(const vector<std::pair<int, int>> &queries,
+                         util::thread_pool *pool = nullptr) const {
+    vector<char> r(queries.size());
+    auto answer = [&](size_t lo, size_t hi, int) {
+      for (auto q = lo; q < hi; ++q)
+        r[q] = reachable(queries[q].first, queries[q].second);
+    };
+    if (pool && queries.size() >= 256)
+      util::parallel_for(*pool, 0, queries.size(), answer);
+    else
+      answer(0, queries.size(), 0);
+    return r;
+  }
+
+  // the hubs in the 2-hop labels, both sides
+  size_t label_entries() const { return _out_hubs.size() + _in_hubs.size(); }
+
+  size_t size_in_bytes() const {
+    return (_component.size() + _d.size() + _f.size() + _out_hubs.size() +
+            _in_hubs.size()) *
+               sizeof(int) +
+           (_out_offsets.size() + _in_offsets.size()) * sizeof(size_t) +
+           _closure.size() * sizeof(uint64_t);
+  }
+
+private:
+  void build_closure(const csr_graph &dag) {
+    _kind = transitive_closure;
+    _closure.assign(_words * _count, 0);
+    // the successors have smaller ids, their rows are done
+    for (int c = 0; c < _count; ++c) {
+      uint64_t *row = &_closure[c * _words];
+      row[c >> 6] |= uint64_t(1) << (c & 63);
+      for (int d : neighbours(dag, c)) {
+        assert(d < c);
+        const uint64_t *from = &_closure[d * _words];
+        // the bits of d's row are all <= d
+        for (size_t w = 0; w <= static_cast<size_t>(d >> 6); ++w)
+          row[w] |= from[w];
+      }
+    }
+  }
+
+  void build_two_hop(const csr_graph &dag) {
+    _kind = two_hop;
+    auto back = transpose(dag);
+    vector<int> hubs(_count);
+    std::iota(hubs.begin(), hubs.end(), 0);
+    auto weight = [&](int c) {
+      return (dag.degree(c) + 1) * (back.degree(c) + 1);
+    };
+    std::stable_sort(hubs.begin(), hubs.end(),
+                     [&](int a, int b) { return weight(a) > weight(b); });
+    // the labels hold the ranks of the hubs, added in increasing order so
+    // each list is sorted
+    vector<vector<int>> out(_count), in(_count);
+    vector<int> seen(_count, -1), queue;
+    auto intersect = [](const vector<int> &a, const vector<int> &b) {
+      size_t i = 0, j = 0;
+      while (i < a.size() && j < b.size()) {
+        if (a[i] == b[j])
+          return true;
+        if (a[i] < b[j])
+          ++i;
+        else
+          ++j;
+      }
+      return false;
+    };
+    // a bfs from h along adj, pruned where the labels already know; forward
+    // adds rank to in(w), backward to out(w)
+    auto search = [&](int h, int rank, const csr_graph &adj, bool forward) {
+      queue.assign(1, h);
+      seen[h] = 2 * rank + forward;
+      for (size_t i = 0; i < queue.size(); ++i) {
+        int w = queue[i];
+        if (forward ? intersect(out[h], in[w]) : intersect(out[w], in[h]))
+          continue;
+        (forward ? in[w] : out[w]).push_back(rank);
+        for (int x : neighbours(adj, w))
+          if (seen[x] != 2 * rank + forward) {
+            seen[x] = 2 * rank + forward;
+            queue.push_back(x);
+          }
+      }
+    };
+    for (int rank = 0; rank < _count; ++rank) {
+      search(hubs[rank], rank, dag, true);
+      search(hubs[rank], rank, back, false);
+    }
+    flatten(out, _out_offsets, _out_hubs);
+    flatten(in, _in_offsets, _in_hubs);
+  }
+
+  static void flatten(vector<vector<int>> &lists, vector<size_t> &offsets,
+                      vector<int> &hubs) {
+    offsets.assign(1, 0);
+    for (auto &l : lists)
+      offsets.push_back(offsets.back() + l.size());
+    hubs.reserve(offsets.back());
+    for (auto &l : lists) {
+      hubs.insert(hubs.end(), l.begin(), l.end());
+      vector<int>().swap(l);
+    }
+  }
+
+  bool share_hub(int c, int d) const {
+    const int *a = _out_hubs.data() + _out_offsets[c],
+              *a_end = _out_hubs.data() + _out_offsets[c + 1];
+    const int *b = _in_hubs.data() + _in_offsets[d],
+              *b_end = _in_hubs.data() + _in_offsets[d + 1];
+    while (a != a_end && b != b_end) {
+      if (*a == *b)
+        return true;
+      if (*a < *b)
+        ++a;
+      else
+        ++b;
+    }
+    return false;
+  }
+
+  vector<int> _component;
+  int _count = 0;
+  vector<int> _d, _f; // dfs intervals of the components
+  kind _kind = transitive_closure;
+  size_t _words = 0;
+  vector<uint64_t> _closure; // row c: the components c reaches
+  vector<size_t> _out_offsets, _in_offsets;
+  vector<int> _out_hubs, _in_hubs;
+};
+}
+}
@@ -0,0 +1,106 @@
+// reordering benchmark: bfs and dijkstra before and after relabelling
+//
+// g++ reorder-bench.cpp -std=c++14 -O2
+// ./a.out [scale=18]
+//
+// The inputs have their vertex ids shuffled, like the ids of real data
+// (hashes, database keys...): an undirected R-MAT graph with 2^scale
+// vertices and 8 * 2^scale edges each way, and a square grid (a mesh, a
+// road network) of about 2^scale vertices.  For each order we report the
+// time to compute it and relabel, the bandwidth and the mean |u - v| over
+// the edges, and the throughput of bfs and dijkstra (edges of the graph
+// per second and per source) on the relabelled graph, from the same
+// sources in original ids.
+
+#include "../../util/bench.hpp"
+#include "../single-source-shortest-path/sssp.hpp"
+#include "bfs.hpp"
+#include "csr.hpp"
+#include "generators.hpp"
+#include "reorder.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+using W = int;
+
+vector<edge> shuffled(int n, const vector<edge> &edges, unsigned seed) {
+  vector<int> id(n);
+  for (int v = 0; v < n; ++v)
+    id[v] = v;
+  shuffle(id.begin(), id.end(), mt19937(seed));
+  vector<edge> r;
+  r.reserve(edges.size());
+  for (auto &e : edges)
+    r.emplace_back(id[e.first], id[e.second]);
+  return r;
+}
+
+double mean_span(const csr_graph &g) {
+  double total = 0;
+  for (int u = 0; u < g.num_vertices(); ++u)
+    for (int v : neighbours(g, u))
+      total += abs(u - v);
+  return total / max<size_t>(1, g.num_edges());
+}
+
+void run(const string &name, int n, const vector<edge> &edges) {
+  weighted_csr_graph<W> g(n, with_random_weights<W>(edges, 1, 1000, 7));
+  // four sources spread over the ids, the graph is connected enough for
+  // each traversal to cover most of it
+  vector<int> sources;
+  for (int v = 0; v < n && sources.size() < 4; v += n / 4 + 1)
+    sources.push_back(v);
+  auto expected = dijkstra(g, sources[0]);
+  double m = g.num_edges() * sources.size();
+
+  printf("\n%s: vertices: %d, edges: %zu\n", name.c_str(), n, g.num_edges());
+  printf("%-10s %10s %10s %12s %10s %10s %10s %10s\n", "order", "build s",
+         "bandwidth", "mean span", "bfs s", "bfs MTEPS", "sssp s",
+         "sssp MTEPS");
+  vector<pair<string, function<vertex_order()>>> orders = {
+      {"shuffled", [&] { return vertex_order::identity(n); }},
+      {"degree", [&] { return degree_order(g); }},
+      {"bfs", [&] { return bfs_order(g); }},
+      {"dfs", [&] { return dfs_order(g); }},
+      {"rcm", [&] { return rcm_order(g); }}};
+  for (auto &o : orders) {
+    vertex_order order;
+    weighted_csr_graph<W> h;
+    double build = best_time(1, [&] {
+      order = o.second();
+      h = relabel(g, order);
+    });
+    double t_bfs = best_time(3, [&] {
+      for (int s : sources)
+        bfs(h, order.new_id(s));
+    });
+    double t_sssp = best_time(3, [&] {
+      for (int s : sources)
+        dijkstra(h, order.new_id(s));
+    });
+    auto check = to_original(dijkstra(h, order.new_id(sources[0])), order);
+    assert(check.dist == expected.dist);
+    (void)check;
+    printf("%-10s %10.4f %10d %12.1f %10.4f %10.2f %10.4f %10.2f\n",
+           o.first.c_str(), build, bandwidth(h), mean_span(h), t_bfs,
+           m / t_bfs / 1e6, t_sssp, m / t_sssp / 1e6);
+  }
+}
+
+int main(int argc, char **argv) {
+  int scale = argc > 1 ? atoi(argv[1]) : 18;
+  int n = 1 << scale, side = static_cast<int>(sqrt(double(n)));
+  run("rmat", n, shuffled(n, symmetrize(rmat_edges(scale, 8, 1)), 2));
+  run("grid", side * side, shuffled(side * side, grid_edges(side, side), 3));
+}
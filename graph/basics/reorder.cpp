@@ -0,0 +1,87 @@
+// vertex reordering, see reorder.hpp
+//
+// g++ reorder.cpp -std=c++14
+
+#include "../single-source-shortest-path/sssp.hpp"
+#include "bfs.hpp"
+#include "csr.hpp"
+#include "dfs.hpp"
+#include "generators.hpp"
+#include "graph.hpp"
+#include "reorder.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+
+int main() {
+  // a 4x4 grid numbered row by row, then shuffled: the neighbours of
+  // a vertex are anywhere
+  const int side = 4, n = side * side;
+  vector<int> shuffled(n);
+  for (int v = 0; v < n; ++v)
+    shuffled[v] = v;
+  shuffle(shuffled.begin(), shuffled.end(), mt19937(1));
+  vector<edge> edges;
+  for (auto &e : grid_edges(side, side))
+    edges.emplace_back(shuffled[e.first], shuffled[e.second]);
+  csr_graph g(n, edges);
+
+  // a row-major grid has bandwidth side, rcm does as well
+  auto rcm = rcm_order(g);
+  auto rg = relabel(g, rcm);
+  cout << "bandwidth: shuffled " << bandwidth(g) << ", rcm " << bandwidth(rg)
+       << "\n";
+  assert(bandwidth(rg) <= side);
+  for (int i = 0; i < n; ++i)
+    assert(rcm.new_id(rcm.old_id(i)) == i);
+
+  // every order gives the same graph up to the names, and the results
+  // translated back are those of the original graph
+  auto expected = bfs(g, 5);
+  for (auto order : {degree_order(g), bfs_order(g), dfs_order(g), rcm,
+                     vertex_order::identity(n)}) {
+    auto h = relabel(g, order);
+    assert(h.num_edges() == g.num_edges());
+    for (int u = 0; u < n; ++u) {
+      assert(h.degree(order.new_id(u)) == g.degree(u));
+      for (int v : neighbours(g, u)) {
+        auto adj = neighbours(h, order.new_id(u));
+        assert(binary_search(adj.begin(), adj.end(), order.new_id(v)));
+      }
+    }
+    auto r = to_original(bfs(h, order.new_id(5)), order);
+    assert(r.source == 5 && r.dist == expected.dist);
+    for (int v = 0; v < n; ++v)
+      if (v != 5)
+        assert(expected.dist[r.parent[v]] + 1 == expected.dist[v]);
+  }
+
+  // the degrees decrease along degree_order
+  auto by_degree = degree_order(g);
+  for (int i = 1; i < n; ++i)
+    assert(g.degree(by_degree.old_id(i - 1)) >= g.degree(by_degree.old_id(i)));
+
+  // the dfs order numbers each vertex by its discovery time: the dfs of the
+  // relabelled graph discovers 0, 1, 2...
+  auto by_dfs = dfs_order(g);
+  auto dr = dfs(relabel(g, by_dfs));
+  for (int i = 0; i < n; ++i)
+    assert(dr.d[i] < (i + 1 < n ? dr.d[i + 1] : 2 * n + 1));
+
+  // weighted graphs keep their weights, the shortest paths translate back
+  auto wg = weighted_csr_graph<int>(
+      1 << 10, with_random_weights<int>(symmetrize(rmat_edges(10, 8, 3)), 1,
+                                        100, 4));
+  auto order = rcm_order(wg);
+  auto sr = to_original(dijkstra(relabel(wg, order), order.new_id(7)), order);
+  assert(sr.dist == dijkstra(wg, 7).dist);
+  // the dfs results too
+  auto dfs_r = to_original(dfs(relabel(wg, order)), order);
+  for (int v = 0; v < wg.num_vertices(); ++v)
+    assert(dfs_r.parent[v] < 0 || dfs_r.d[dfs_r.parent[v]] < dfs_r.d[v]);
+}
@@ -0,0 +1,312 @@
+// vertex reordering for cache locality
+//
+// The ids of the vertices are whatever the input used, and on real data the
+// neighbours of a vertex end up all over the id range: every dist[v] or
+// parent[v] a traversal touches is a cache miss, and bfs/sssp wait on the
+// memory instead of computing.  Renumbering the vertices so that the
+// vertices visited together have close ids puts them in the same cache
+// lines (and pages) of the per-vertex arrays, and of the CSR arrays.
+//
+// A vertex_order is a permutation: new_id(v) is the id of the original
+// vertex v in the relabelled graph, old_id(i) the original id of the
+// relabelled vertex i.  The orders:
+//
+//   degree_order   the highest degrees first.  The hubs, touched by most
+//                  of the edges, are packed together at the start.
+//   bfs_order      the order in which a bfs discovers the vertices (from
+//                  vertex 0, then from the first vertex not reached yet...)
+//                  one level after the other, the way bfs walks them again.
+//   dfs_order      the order of the discovery times (dfs_node's
+//                  discovery_time, dfs_result::d), a path is numbered
+//                  contiguously.
+//   rcm_order      reverse Cuthill-McKee: a bfs starting from a
+//                  pseudo-peripheral vertex (one at the end of a longest
+//                  shortest path, found by repeated bfs) where each vertex
+//                  enqueues its neighbours by increasing degree, the whole
+//                  order reversed.  It minimizes the bandwidth (max |u - v|
+//                  over the edges) in practice: the classic ordering for
+//                  sparse matrices, and for meshes and road networks.
+//
+// The orders follow the out-neighbours, they're meant for undirected
+// graphs (both directions stored); symmetrize a directed one first.
+//
+// relabel(g, order) builds the relabelled graph in CSR form, the
+// neighbours of each vertex sorted by their new id.  The algorithms run on
+// it and to_original(r, order) brings their results back to the original
+// ids.  Computing an order and relabelling cost a few traversals, it pays
+// off when the graph is traversed many times (see reorder-bench.cpp).
+#pragma once
+
+#include "csr.hpp"
+#include "dfs.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::size_t;
+using std::vector;
+
+class vertex_order {
+public:
+  vertex_order() {}
+  // order[i] is the original id of the vertex numbered i
+  explicit vertex_order(vector<int> order)
+      : _old(std::move(order)), _new(_old.size(), -1) {
+    for (int i = 0; i < size(); ++i) {
+      assert(_new[_old[i]] == -1); // a permutation
+      _new[_old[i]] = i;
+    }
+  }
+  static vertex_order identity(int n) {
+    vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    return vertex_order(std::move(order));
+  }
+
+  int size() const { return static_cast<int>(_old.size()); }
+  int new_id(int v) const { return _new[v]; }
+  int old_id(int i) const { return _old[i]; }
+
+  // a value per vertex, indexed by the new ids, indexed by the original ids
+  template <class T> vector<T> values_to_original(const vector<T> &x) const {
+    vector<T> r(x.size());
+    for (int v = 0; v < size(); ++v)
+      r[v] = x[_new[v]];
+    return r;
+  }
+
+  // the same for a vertex per vertex (a parent...), the vertices are
+  // translated as well, the negative ones (no vertex) are kept
+  vector<int> vertices_to_original(const vector<int> &x) const {
+    vector<int> r(x.size());
+    for (int v = 0; v < size(); ++v) {
+      int u = x[_new[v]];
+      r[v] = u < 0 ? u : _old[u];
+    }
+    return r;
+  }
+
+private:
+  vector<int> _old; // new id -> old id
+  vector<int> _new; // old id -> new id
+};
+
+template <class G> size_t out_degree(const G &g, int u) {
+  auto adj = neighbours(g, u);
+  return static_cast<size_t>(std::distance(adj.begin(), adj.end()));
+}
+
+// the vertices sorted by decreasing degree, ties in id order (counting
+// sort)
+template <class G> vertex_order degree_order(const G &g) {
+  const int n = num_vertices(g);
+  vector<size_t> degree(n);
+  size_t max_degree = 0;
+  for (int u = 0; u < n; ++u)
+    max_degree = std::max(max_degree, degree[u] = out_degree(g, u));
+  vector<int> start(max_degree + 2, 0);
+  for (int u = 0; u < n; ++u)
+    ++start[max_degree - degree[u] + 1];
+  for (size_t d = 0; d <= max_degree; ++d)
+    start[d + 1] += start[d];
+  vector<int> order(n);
+  for (int u = 0; u < n; ++u)
+    order[start[max_degree - degree[u]]++] = u;
+  return vertex_order(std::move(order));
+}
+
+template <class G> vertex_order bfs_order(const G &g) {
+  const int n = num_vertices(g);
+  vector<bool> seen(n, false);
+  vector<int> order; // doubles as the queue
+  order.reserve(n);
+  for (int s = 0; s < n; ++s) {
+    if (seen[s])
+      continue;
+    seen[s] = true;
+    order.push_back(s);
+    for (size_t u = order.size() - 1; u < order.size(); ++u)
+      for (int v : neighbours(g, order[u]))
+        if (!seen[v]) {
+          seen[v] = true;
+          order.push_back(v);
+        }
+  }
+  return vertex_order(std::move(order));
+}
+
+template <class G> vertex_order dfs_order(const G &g) {
+  auto r = dfs(g);
+  // the times are distinct and in 1..2V, a bucket per time
+  vector<int> at_time(2 * r.d.size() + 1, -1);
+  for (int v = 0; v < static_cast<int>(r.d.size()); ++v)
+    at_time[r.d[v]] = v;
+  vector<int> order;
+  order.reserve(r.d.size());
+  for (int v : at_time)
+    if (v >= 0)
+      order.push_back(v);
+  return vertex_order(std::move(order));
+}
+
+template <class G> vertex_order rcm_order(const G &g) {
+  const int n = num_vertices(g);
+  vector<size_t> degree(n);
+  for (int u = 0; u < n; ++u)
+    degree[u] = out_degree(g, u);
+  auto by_degree = [&](int a, int b) {
+    return degree[a] != degree[b] ? degree[a] < degree[b] : a < b;
+  };
+
+  // The bfs levels from s: returns the number of levels and sets last to
+  // the vertex of smallest degree in the last one.  The vertices reached
+  // are left in queue, their level in level (reset by the caller).
+  vector<int> level(n, -1), queue;
+  auto levels_from = [&](int s, int &last) {
+    queue.assign(1, s);
+    level[s] = 0;
+    last = s;
+    for (size_t i = 0; i < queue.size(); ++i) {
+      int u = queue[i];
+      if (level[u] > level[last] ||
+          (level[u] == level[last] && by_degree(u, last)))
+        last = u;
+      for (int v : neighbours(g, u))
+        if (level[v] < 0) {
+          level[v] = level[u] + 1;
+          queue.push_back(v);
+        }
+    }
+    return level[last] + 1;
+  };
+  auto reset_levels = [&] {
+    for (int u : queue)
+      level[u] = -1;
+  };
+
+  vector<int> start(n);
+  std::iota(start.begin(), start.end(), 0);
+  std::sort(start.begin(), start.end(), by_degree);
+  vector<bool> numbered(n, false);
+  vector<int> order, next;
+  order.reserve(n);
+  for (int s : start) {
+    if (numbered[s])
+      continue;
+    // pseudo-peripheral vertex (George and Liu): from the vertex of
+    // smallest degree of the component, jump to the end of the deepest
+    // level structure as long as it gets deeper
+    int last, depth = levels_from(s, last);
+    reset_levels();
+    while (last != s) {
+      int candidate, candidate_depth = levels_from(last, candidate);
+      reset_levels();
+      if (candidate_depth <= depth)
+        break;
+      s = last;
+      last = candidate;
+      depth = candidate_depth;
+    }
+    // Cuthill-McKee from there
+    numbered[s] = true;
+    order.push_back(s);
+    for (size_t u = order.size() - 1; u < order.size(); ++u) {
+      next.clear();
+      for (int v : neighbours(g, order[u]))
+        if (!numbered[v]) {
+          numbered[v] = true;
+          next.push_back(v);
+        }
+      std::sort(next.begin(), next.end(), by_degree);
+      order.insert(order.end(), next.begin(), next.end());
+    }
+  }
+  std::reverse(order.begin(), order.end());
+  return vertex_order(std::move(order));
+}
+
+// the offsets of the relabelled graph: vertex i has the degree of
+// old_id(i)
+template <class G>
+vector<size_t> relabelled_offsets(const G &g, const vertex_order &order) {
+  const int n = num_vertices(g);
+  assert(order.size() == n);
+  vector<size_t> offsets(n + 1, 0);
+  for (int i = 0; i < n; ++i)
+    offsets[i + 1] = offsets[i] + out_degree(g, order.old_id(i));
+  return offsets;
+}
+
+template <class G> csr_graph relabel(const G &g, const vertex_order &order) {
+  csr_graph r;
+  r.offsets = relabelled_offsets(g, order);
+  r.targets.resize(r.offsets.back());
+  for (int i = 0; i < order.size(); ++i) {
+    auto out = r.targets.begin() + r.offsets[i];
+    for (int v : neighbours(g, order.old_id(i)))
+      *out++ = order.new_id(v);
+    std::sort(r.targets.begin() + r.offsets[i], out);
+  }
+  return r;
+}
+
+template <class W>
+weighted_csr_graph<W> relabel(const weighted_csr_graph<W> &g,
+                              const vertex_order &order) {
+  weighted_csr_graph<W> r;
+  r.offsets = relabelled_offsets(g, order);
+  r.targets.resize(r.offsets.back());
+  r.weights.resize(r.offsets.back());
+  vector<arc<W>> adj;
+  for (int i = 0; i < order.size(); ++i) {
+    adj.clear();
+    for (auto a : out_edges(g, order.old_id(i)))
+      adj.push_back(arc<W>{order.new_id(a.to), a.weight});
+    std::sort(adj.begin(), adj.end(),
+              [](const arc<W> &a, const arc<W> &b) { return a.to < b.to; });
+    for (size_t k = 0; k < adj.size(); ++k) {
+      r.targets[r.offsets[i] + k] = adj[k].to;
+      r.weights[r.offsets[i] + k] = adj[k].weight;
+    }
+  }
+  return r;
+}
+
+// The results of a traversal of the relabelled graph in the original ids.
+// Anything with a source, a dist and a parent array: bfs_result,
+// sssp_result...
+template <class Result>
+Result to_original(const Result &r, const vertex_order &order) {
+  Result o(r);
+  o.source = r.source < 0 ? r.source : order.old_id(r.source);
+  o.dist = order.values_to_original(r.dist);
+  o.parent = order.vertices_to_original(r.parent);
+  return o;
+}
+
+inline dfs_result to_original(const dfs_result &r, const vertex_order &order) {
+  dfs_result o(r);
+  o.d = order.values_to_original(r.d);
+  o.f = order.values_to_original(r.f);
+  o.parent = order.vertices_to_original(r.parent);
+  return o;
+}
+
+// max |u - v| over the edges, what rcm_order keeps small
+template <class G> int bandwidth(const G &g) {
+  int b = 0;
+  for (int u = 0; u < num_vertices(g); ++u)
+    for (int v : neighbours(g, u))
+      b = std::max(b, u < v ? v - u : u - v);
+  return b;
+}
+}
+}
@@ -13,30 +13,95 @@
 // 4. output the vertices of each tree in the depth-first forest of 3 as
 //    a separate SCC.
 //
+// The engines we run (an iterative Tarjan and a parallel trim +
+// forward-backward + coloring) are in scc.hpp.
+//
+// g++ scc.cpp -std=c++14 -pthread
+
+#include "csr.hpp"
+#include "graph.hpp"
+#include "named-graph.hpp"
+#include "scc.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+
+// two component labelings describe the same partition
+bool same_partition(const vector<int> &a, const vector<int> &b) {
+  for (size_t u = 0; u < a.size(); ++u)
+    for (size_t v = 0; v < a.size(); ++v)
+      if ((a[u] == a[v]) != (b[u] == b[v]))
+        return false;
+  return true;
+}
 
 int main() {
 
-  fixed_graph<topo_node, 8> dag;
-  dag.add(topo_node(0, "a"));
-  dag.add(topo_node(1, "b"));
-  dag.add(topo_node(2, "c"));
-  dag.add(topo_node(3, "d"));
-  dag.add(topo_node(4, "e"));
-  dag.add(topo_node(5, "f"));
-  dag.add(topo_node(6, "g"));
-  dag.add(topo_node(7, "h"));
-  dag.add(topo_node(0, "a"), topo_node(1, "b"));
-  dag.add(topo_node(1, "b"), topo_node(2, "c"));
-  dag.add(topo_node(1, "b"), topo_node(4, "e"));
-  dag.add(topo_node(1, "b"), topo_node(5, "f"));
-  dag.add(topo_node(2, "c"), topo_node(3, "d"));
-  dag.add(topo_node(2, "c"), topo_node(6, "g"));
-  dag.add(topo_node(3, "d"), topo_node(2, "c"));
-  dag.add(topo_node(3, "d"), topo_node(7, "h"));
-  dag.add(topo_node(4, "e"), topo_node(0, "a"));
-  dag.add(topo_node(4, "e"), topo_node(5, "f"));
-  dag.add(topo_node(5, "f"), topo_node(6, "g"));
-  dag.add(topo_node(6, "g"), topo_node(5, "f"));
-  dag.add(topo_node(6, "g"), topo_node(7, "h"));
-  dag.add(topo_node(7, "h"), topo_node(7, "h"));
+  // CLRS P.616 Figure 22.9, built by name: the vertices get their ids in
+  // order of first appearance, a b c e f d g h
+  named_graph_builder b;
+  for (auto e : {make_pair("a", "b"), make_pair("b", "c"), make_pair("b", "e"),
+                 make_pair("b", "f"), make_pair("c", "d"), make_pair("c", "g"),
+                 make_pair("d", "c"), make_pair("d", "h"), make_pair("e", "a"),
+                 make_pair("e", "f"), make_pair("f", "g"), make_pair("g", "f"),
+                 make_pair("g", "h"), make_pair("h", "h")})
+    b.add_edge(e.first, e.second);
+  auto dag = b.build();
+  auto at = [&](const char *name) { return dag.id(name); };
+
+  auto r = tarjan_scc(dag);
+  for (int c = 0; c < r.count; ++c) {
+    cout << "scc " << c << ": ";
+    for (int v = 0; v < dag.num_vertices(); ++v)
+      if (r.component[v] == c)
+        cout << dag.name(v) << " ";
+    cout << "-> ";
+    for (int d : neighbours(r.condensation, c))
+      cout << d << " ";
+    cout << "\n";
+  }
+  // {a, b, e}, {c, d}, {f, g}, {h}
+  auto component = [&](const char *name) { return r.component[at(name)]; };
+  assert(r.count == 4);
+  assert(component("a") == component("b") && component("b") == component("e"));
+  assert(component("c") == component("d"));
+  assert(component("f") == component("g"));
+  // component 0 is a sink of the condensation: {h}
+  assert(component("h") == 0 && neighbours(r.condensation, 0).empty());
+  assert(r.condensation.num_edges() == 5);
+
+  vector<edge> edges;
+  for (int u = 0; u < 8; ++u)
+    for (int v : neighbours(dag, u))
+      edges.emplace_back(u, v);
+  csr_graph g(8, edges);
+  for (int threads = 1; threads <= 4; ++threads) {
+    auto pr = parallel_scc(g, transpose(g), threads);
+    assert(pr.count == r.count);
+    assert(same_partition(pr.component, r.component));
+  }
+
+  // a long chain with a back edge every 1000 vertices, deep enough to blow
+  // a recursive dfs
+  const int n = 1000000;
+  edges.clear();
+  for (int v = 0; v < n; ++v) {
+    if (v + 1 < n)
+      edges.emplace_back(v, v + 1);
+    if (v % 1000 == 999)
+      edges.emplace_back(v, v - 999);
+  }
+  csr_graph chain(n, edges);
+  auto cr = tarjan_scc(chain);
+  assert(cr.count == n / 1000);
+  auto pcr = parallel_scc(chain, transpose(chain), 2);
+  assert(pcr.count == cr.count);
+  for (int v = 1; v < n; ++v)
+    assert((cr.component[v] == cr.component[v - 1]) ==
+           (pcr.component[v] == pcr.component[v - 1]));
 }
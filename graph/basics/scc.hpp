@@ -0,0 +1,315 @@
+// strongly connected components (CLRS 22.5)
+//
+// scc.cpp describes the two-pass algorithm of CLRS (Kosaraju).  Here are
+// the two engines we actually run:
+//
+// tarjan_scc: Tarjan's single-pass algorithm.  One dfs, each vertex gets
+//   index[v] (its discovery order) and low[v], the smallest index reachable
+//   from the dfs subtree of v through at most one back edge to a vertex
+//   still on the component stack.  When v finishes with low[v] == index[v],
+//   v is the root of a component, and that component is exactly what's on
+//   the component stack above v.  The dfs is driven by an explicit stack of
+//   dfs_frame (the same as dfs_visit in dfs.hpp) so deep graphs don't
+//   overflow the call stack.  The components come out in reverse
+//   topological order: component 0 is a sink of the condensation.
+//
+// parallel_scc: for big graphs, on a thread pool.
+//   1. trim: a vertex with no in-edge or no out-edge (among the vertices
+//      not assigned yet) is a component by itself, repeat while it helps.
+//   2. forward-backward: from a pivot, the vertices both reachable from it
+//      and reaching it (two parallel bfs) form its component.  With the
+//      pivot picked among the highest degrees this takes the giant
+//      component of real-world graphs in one go.
+//   3. coloring for the rest: every vertex starts with its own id as color
+//      and the largest color is propagated along the edges until nothing
+//      changes.  A vertex whose color is still its own id is the largest
+//      of its component, and its component is the set of vertices of the
+//      same color reaching it (backward search restricted to the color).
+//      Assign those, repeat with the remaining vertices.
+//   The component ids depend on the scheduling, the partition doesn't.
+//
+// Both return the component of every vertex and the condensation: the DAG
+// with one vertex per component and an edge between two components when an
+// edge of g goes from one to the other.
+#pragma once
+
+#include "../../util/parallel.hpp"
+#include "csr.hpp"
+#include "dfs.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <stack>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::vector;
+
+class scc_result {
+public:
+  vector<int> component; // component id of each vertex, in 0..count-1
+  int count = 0;
+  csr_graph condensation; // count vertices, no duplicate edge, no loop
+};
+
+template <class G>
+csr_graph condensation(const G &g, const vector<int> &component, int count) {
+  vector<edge> edges;
+  for (int u = 0; u < num_vertices(g); ++u)
+    for (int v : neighbours(g, u))
+      if (component[u] != component[v])
+        edges.emplace_back(component[u], component[v]);
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  return csr_graph(count, edges);
+}
+
+template <class G> scc_result tarjan_scc(const G &g) {
+  const int n = num_vertices(g);
+  scc_result r;
+  r.component.assign(n, -1);
+  vector<int> index(n, -1), low(n, 0);
+  // a vertex is on the component stack iff it's indexed but not assigned
+  vector<int> members;
+  using iterator = decltype(neighbours(g, 0).begin());
+  std::stack<dfs_frame<iterator>> stk;
+  int next_index = 0;
+  auto discover = [&](int v) {
+    index[v] = low[v] = next_index++;
+    members.push_back(v);
+    auto adj = neighbours(g, v);
+    stk.push(dfs_frame<iterator>{v, adj.begin(), adj.end()});
+  };
+
+  for (int root = 0; root < n; ++root) {
+    if (index[root] >= 0)
+      continue;
+    discover(root);
+    while (!stk.empty()) {
+      auto &top = stk.top();
+      int u = top.u;
+      if (top.next != top.last) {
+        int w = *top.next++;
+        if (index[w] < 0)
+          discover(w); // invalidates top
+        else if (r.component[w] < 0)
+          low[u] = std::min(low[u], index[w]);
+        continue;
+      }
+      // u is finished
+      stk.pop();
+      if (!stk.empty())
+        low[stk.top().u] = std::min(low[stk.top().u], low[u]);
+      if (low[u] != index[u])
+        continue;
+      int w;
+      do {
+        w = members.back();
+        members.pop_back();
+        r.component[w] = r.count;
+      } while (w != u);
+      ++r.count;
+    }
+  }
+  r.condensation = condensation(g, r.component, r.count);
+  return r;
+}
+
+// gt is the transpose of g (see transpose() in csr.hpp)
+template <class G, class GT>
+scc_result parallel_scc(const G &g, const GT &gt, util::thread_pool &pool) {
+  const int n = num_vertices(g);
+  assert(num_vertices(gt) == n);
+  vector<std::atomic<int>> comp(n);
+  std::atomic<int> count(0);
+  util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+    for (auto v = lo; v < hi; ++v)
+      comp[v].store(-1, std::memory_order_relaxed);
+  });
+  auto assigned = [&](int v) {
+    return comp[v].load(std::memory_order_relaxed) >= 0;
+  };
+
+  // 1. trim
+  auto trim = [&] {
+    for (;;) {
+      std::atomic<bool> changed(false);
+      util::parallel_for_dynamic(pool, 0, n, 1024, [&](size_t lo, size_t hi,
+                                                       int) {
+        for (auto v = lo; v < hi; ++v) {
+          if (assigned(v))
+            continue;
+          bool has_out = false, has_in = false;
+          for (int u : neighbours(g, v))
+            if (u != static_cast<int>(v) && !assigned(u)) {
+              has_out = true;
+              break;
+            }
+          if (has_out)
+            for (int u : neighbours(gt, v))
+              if (u != static_cast<int>(v) && !assigned(u)) {
+                has_in = true;
+                break;
+              }
+          if (!has_out || !has_in) {
+            comp[v].store(count.fetch_add(1), std::memory_order_relaxed);
+            changed.store(true, std::memory_order_relaxed);
+          }
+        }
+      });
+      if (!changed.load())
+        return;
+    }
+  };
+
+  // parallel bfs from the vertices of frontier, only through the vertices
+  // accepted by allowed(v), marking them in mark (frontier already marked)
+  vector<std::atomic<char>> fw(n), bw(n);
+  vector<vector<int>> local(pool.size());
+  auto reach = [&](const auto &graph, vector<int> frontier,
+                   vector<std::atomic<char>> &mark, const auto &allowed) {
+    vector<int> next;
+    auto expand = [&](size_t lo, size_t hi, int tid) {
+      for (auto i = lo; i < hi; ++i)
+        for (int v : neighbours(graph, frontier[i]))
+          if (!mark[v].load(std::memory_order_relaxed) && allowed(v) &&
+              !mark[v].exchange(1, std::memory_order_relaxed))
+            local[tid].push_back(v);
+    };
+    while (!frontier.empty()) {
+      // waking up the pool for a handful of vertices costs more than it
+      // saves, and long paths make for many such levels
+      if (frontier.size() < 256)
+        expand(0, frontier.size(), 0);
+      else
+        util::parallel_for_dynamic(pool, 0, frontier.size(), 64, expand);
+      next.clear();
+      for (auto &l : local) {
+        next.insert(next.end(), l.begin(), l.end());
+        l.clear();
+      }
+      frontier.swap(next);
+    }
+  };
+  auto clear_marks = [&] {
+    util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+      for (auto v = lo; v < hi; ++v) {
+        fw[v].store(0, std::memory_order_relaxed);
+        bw[v].store(0, std::memory_order_relaxed);
+      }
+    });
+  };
+
+  trim();
+
+  // 2. forward-backward from the pivot of largest in * out degree
+  int pivot = -1;
+  size_t best = 0;
+  for (int v = 0; v < n; ++v) {
+    if (assigned(v))
+      continue;
+    size_t score = neighbours(g, v).size() * neighbours(gt, v).size();
+    if (pivot < 0 || score > best) {
+      pivot = v;
+      best = score;
+    }
+  }
+  if (pivot >= 0) {
+    clear_marks();
+    auto unassigned = [&](int v) { return !assigned(v); };
+    fw[pivot].store(1);
+    bw[pivot].store(1);
+    reach(g, vector<int>(1, pivot), fw, unassigned);
+    reach(gt, vector<int>(1, pivot), bw, unassigned);
+    int id = count.fetch_add(1);
+    util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+      for (auto v = lo; v < hi; ++v)
+        if (fw[v].load(std::memory_order_relaxed) &&
+            bw[v].load(std::memory_order_relaxed))
+          comp[v].store(id, std::memory_order_relaxed);
+    });
+    trim();
+  }
+
+  // 3. coloring
+  vector<std::atomic<int>> color(n);
+  for (;;) {
+    std::atomic<bool> left(false);
+    util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+      for (auto v = lo; v < hi; ++v) {
+        color[v].store(v, std::memory_order_relaxed);
+        if (!assigned(v))
+          left.store(true, std::memory_order_relaxed);
+      }
+    });
+    if (!left.load())
+      break;
+    for (bool changed = true; changed;) {
+      std::atomic<bool> any(false);
+      util::parallel_for_dynamic(pool, 0, n, 1024, [&](size_t lo, size_t hi,
+                                                       int) {
+        for (auto v = lo; v < hi; ++v) {
+          if (assigned(v))
+            continue;
+          int c = color[v].load(std::memory_order_relaxed);
+          for (int u : neighbours(g, v)) {
+            if (assigned(u))
+              continue;
+            int old = color[u].load(std::memory_order_relaxed);
+            while (old < c && !color[u].compare_exchange_weak(
+                                  old, c, std::memory_order_relaxed))
+              ;
+            if (old < c)
+              any.store(true, std::memory_order_relaxed);
+          }
+        }
+      });
+      changed = any.load();
+    }
+    // the roots: unassigned vertices that kept their own color
+    vector<int> roots;
+    for (int v = 0; v < n; ++v)
+      if (!assigned(v) && color[v].load(std::memory_order_relaxed) == v)
+        roots.push_back(v);
+    // each root owns its color, the backward searches are disjoint so they
+    // run side by side, each on one thread
+    util::parallel_for_dynamic(pool, 0, roots.size(), 1, [&](size_t lo,
+                                                             size_t hi, int) {
+      vector<int> todo;
+      for (auto i = lo; i < hi; ++i) {
+        int root = roots[i], id = count.fetch_add(1);
+        comp[root].store(id, std::memory_order_relaxed);
+        todo.assign(1, root);
+        while (!todo.empty()) {
+          int v = todo.back();
+          todo.pop_back();
+          for (int u : neighbours(gt, v)) {
+            if (assigned(u) || color[u].load(std::memory_order_relaxed) != root)
+              continue;
+            comp[u].store(id, std::memory_order_relaxed);
+            todo.push_back(u);
+          }
+        }
+      }
+    });
+  }
+
+  scc_result r;
+  r.count = count.load();
+  r.component.resize(n);
+  for (int v = 0; v < n; ++v)
+    r.component[v] = comp[v].load(std::memory_order_relaxed);
+  r.condensation = condensation(g, r.component, r.count);
+  return r;
+}
+
+template <class G, class GT>
+scc_result parallel_scc(const G &g, const GT &gt, int threads) {
+  util::thread_pool pool(threads);
+  return parallel_scc(g, gt, pool);
+}
+}
+}
@@ -0,0 +1,115 @@
+// topological sort, see toposort.hpp
+//
+// g++ toposort.cpp -std=c++14
+
+#include "csr.hpp"
+#include "dfs.hpp"
+#include "graph.hpp"
+#include "named-graph.hpp"
+#include "toposort.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+
+template <class G> bool is_topological_order(const G &g, vector<int> order) {
+  vector<int> position(num_vertices(g), -1);
+  for (size_t i = 0; i < order.size(); ++i)
+    position[order[i]] = i;
+  for (int u = 0; u < num_vertices(g); ++u)
+    for (int v : neighbours(g, u))
+      if (position[u] >= position[v])
+        return false;
+  return true;
+}
+
+int main() {
+
+  // Professor Bumstead gets dressed, CLRS P.613 Figure 22.7.  The clothes
+  // are named once, the graph holds their ids.
+  named_graph_builder b;
+  b.add_edge("undershorts", "pants");
+  b.add_edge("undershorts", "shoes");
+  b.add_edge("pants", "belt");
+  b.add_edge("pants", "shoes");
+  b.add_edge("belt", "jacket");
+  b.add_edge("shirt", "belt");
+  b.add_edge("shirt", "tie");
+  b.add_edge("tie", "jacket");
+  b.add_edge("socks", "shoes");
+  b.add_vertex("watch"); // no edge at all
+  auto dressing = b.build();
+  assert(dressing.num_vertices() == 9);
+
+  auto kahn = topological_sort(dressing);
+  auto by_finish = dfs_topological_sort(dressing);
+  for (auto order : {kahn, by_finish}) {
+    assert(is_topological_order(dressing, order));
+    for (int v : order)
+      cout << dressing.name(v) << " ";
+    cout << "\n";
+  }
+
+  // the order is kept up to date while the same edges come in one by one
+  incremental_topological_order online(9);
+  for (int u = 0; u < 9; ++u)
+    for (int v : neighbours(dressing, u))
+      online.add_edge(u, v);
+  assert(is_topological_order(dressing, online.order()));
+  try {
+    // the jacket before the shirt?
+    online.add_edge(dressing.id("jacket"), dressing.id("shirt"));
+    assert(false);
+  } catch (const cycle_error &e) {
+    cout << e.what() << "\n";
+  }
+  assert(is_topological_order(dressing, online.order()));
+
+  // 0 -> 1 is left by Kahn's algorithm too, but only 2 <-> 3 is a cycle
+  csr_graph tail(4, {{0, 1}, {2, 3}, {3, 2}, {3, 0}});
+  for (auto sort : {topological_sort<csr_graph>,
+                    dfs_topological_sort<csr_graph>}) {
+    try {
+      sort(tail);
+      assert(false);
+    } catch (const cycle_error &e) {
+      assert((e.u == 2 && e.v == 3) || (e.u == 3 && e.v == 2));
+    }
+  }
+
+  // random insertions: the online order must match what a batch sort
+  // accepts, and refuse exactly the edges closing a cycle
+  const int n = 300;
+  mt19937 rng(7);
+  vector<edge> edges;
+  incremental_topological_order order(n);
+  int refused = 0;
+  for (int i = 0; i < 3000; ++i) {
+    int u = rng() % n, v = rng() % n;
+    edges.emplace_back(u, v);
+    bool acyclic = true;
+    try {
+      topological_sort(csr_graph(n, edges));
+    } catch (const cycle_error &e) {
+      acyclic = false;
+      // the edge reported is on a cycle: its target reaches its source
+      csr_graph g(n, edges);
+      dfs_result r(n);
+      dfs_visit(g, e.v, r);
+      assert(r.discovered(e.u));
+      edges.pop_back();
+    }
+    try {
+      order.add_edge(u, v);
+      assert(acyclic);
+    } catch (const cycle_error &) {
+      assert(!acyclic);
+      ++refused;
+    }
+  }
+  assert(is_topological_order(csr_graph(n, edges), order.order()));
+  cout << edges.size() << " edges inserted, " << refused << " refused\n";
+}
@@ -1,7 +1,34 @@
+// topological sort (CLRS 22.4)
+//
+// A topological order of a DAG is an ordering of the vertices such that
+// for every edge (u, v), u comes before v.
+//
+// Batch versions:
+//  topological_sort: Kahn's algorithm, repeatedly take a vertex with no
+//    remaining in-edge (in-degree array + queue).  O(V+E).
+//  dfs_topological_sort: the CLRS one, the vertices by decreasing finish
+//    time of a dfs (dfs_result::f).  O(V+E).
+// Both throw cycle_error when the graph isn't a DAG.
+//
+// Online version:
+//  incremental_topological_order keeps an order while edges are inserted
+//  (Pearce and Kelly, "A dynamic topological sort algorithm for directed
+//  acyclic graphs").  Inserting (x, y) with x already before y changes
+//  nothing.  Otherwise only the vertices whose position is between those of
+//  y and x can be affected:
+//   delta_f: the vertices reachable from y, positioned before x
+//   delta_b: the vertices reaching x, positioned after y
+//  If x is in delta_f the edge closes a cycle.  If not, delta_b is moved in
+//  front of delta_f, reusing exactly the positions they occupied (each set
+//  keeps its relative order).  The cost depends on the size of the affected
+//  region, not on the size of the graph.
 #pragma once
 #include "dfs.hpp"
 #include "graph.hpp"
+#include <algorithm>
+#include <cassert>
 #include <stack>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -9,18 +36,23 @@ namespace clrs {
 namespace graph {
 
 using std::string;
+using std::vector;
 
+// A node of fixed_graph with a name.  Every edge stores a copy of its
+// target, name included: fine for the small examples, for big named graphs
+// see named-graph.hpp.
 class topo_node : public dfs_node {
 
 public:
   topo_node() : dfs_node() {}
   topo_node(int id, const string &name) : dfs_node(id), name(name) {}
   topo_node(const topo_node &other) : dfs_node(other), name(other.name) {}
+  topo_node &operator=(const topo_node &other) = default;
   virtual ~topo_node() {}
   string name;
 };
 
-ostream &operator<<(ostream &stream, const topo_node &n) {
+inline ostream &operator<<(ostream &stream, const topo_node &n) {
   stream << "id: " << n.id << ", name: " << n.name << ", dist: " << n.dist
          << ", dtime: " << n.discovery_time
          << ", finish time: " << n.finish_time << ", prev: ";
@@ -28,6 +60,191 @@ ostream &operator<<(ostream &stream, const topo_node &n) {
     stream << n.prev->id;
   else
     stream << "null";
+  return stream;
 }
+class cycle_error : public std::runtime_error {
+public:
+  cycle_error(int u, int v)
+      : std::runtime_error("edge (" + std::to_string(u) + ", " +
+                           std::to_string(v) + ") closes a cycle"),
+        u(u), v(v) {}
+  int u, v; // an edge lying on a cycle
+};
+
+template <class G> vector<int> topological_sort(const G &g) {
+  const int n = num_vertices(g);
+  vector<int> in_degree(n, 0), order;
+  order.reserve(n);
+  for (int u = 0; u < n; ++u)
+    for (int v : neighbours(g, u))
+      ++in_degree[v];
+  for (int u = 0; u < n; ++u)
+    if (in_degree[u] == 0)
+      order.push_back(u);
+  // order doubles as the queue: the vertices before i have been output
+  // and their edges removed
+  for (size_t i = 0; i < order.size(); ++i)
+    for (int v : neighbours(g, order[i]))
+      if (--in_degree[v] == 0)
+        order.push_back(v);
+  if (static_cast<int>(order.size()) != n) {
+    // The vertices left all have an in-edge from another vertex left, but
+    // such an edge may only lead to a cycle.  Going backwards along these
+    // in-edges from any vertex left comes back to a vertex already seen:
+    // the edges walked since then are a cycle.
+    vector<int> pred(n, -1);
+    for (int u = 0; u < n; ++u)
+      if (in_degree[u] > 0)
+        for (int v : neighbours(g, u))
+          if (in_degree[v] > 0)
+            pred[v] = u;
+    int v = 0;
+    while (in_degree[v] == 0)
+      ++v;
+    vector<char> seen(n, 0);
+    for (; !seen[v]; v = pred[v])
+      seen[v] = 1;
+    throw cycle_error(pred[v], v);
+  }
+  return order;
+}
+
+template <class G> vector<int> dfs_topological_sort(const G &g) {
+  const int n = num_vertices(g);
+  auto r = dfs(g);
+  // the finish times are distinct and in 1..2V, a bucket per time sorts
+  // them in linear time
+  vector<int> by_finish(2 * n + 1, -1), order;
+  order.reserve(n);
+  for (int u = 0; u < n; ++u)
+    by_finish[r.f[u]] = u;
+  for (int t = 2 * n; t > 0; --t)
+    if (by_finish[t] >= 0)
+      order.push_back(by_finish[t]);
+  // an edge going to a vertex finishing later is a back edge
+  for (int u = 0; u < n; ++u)
+    for (int v : neighbours(g, u))
+      if (r.f[v] >= r.f[u])
+        throw cycle_error(u, v);
+  return order;
+}
+
+class incremental_topological_order {
+public:
+  explicit incremental_topological_order(int n = 0) { resize(n); }
+
+  int num_vertices() const { return static_cast<int>(_ord.size()); }
+  // a new vertex goes at the end of the order
+  int add_vertex() {
+    resize(num_vertices() + 1);
+    return num_vertices() - 1;
+  }
+
+  // Throws cycle_error, and leaves the graph and the order untouched, if
+  // the edge would close a cycle.
+  void add_edge(int x, int y) {
+    assert(x < num_vertices() && y < num_vertices());
+    if (x == y)
+      throw cycle_error(x, y);
+    int lb = _ord[y], ub = _ord[x];
+    if (lb > ub) {
+      _out[x].push_back(y);
+      _in[y].push_back(x);
+      return;
+    }
+    _delta_f.clear();
+    _delta_b.clear();
+    bool cycle = !search(y, ub, _out, _delta_f, [](int o, int bound) {
+      return o < bound;
+    }, x);
+    if (cycle) {
+      for (int v : _delta_f)
+        _mark[v] = false;
+      throw cycle_error(x, y);
+    }
+    search(x, lb, _in, _delta_b, [](int o, int bound) { return o > bound; },
+           -1);
+    reorder();
+    _out[x].push_back(y);
+    _in[y].push_back(x);
+  }
+
+  // position of v in the order
+  int position(int v) const { return _ord[v]; }
+  bool precedes(int u, int v) const { return _ord[u] < _ord[v]; }
+  // the vertices in topological order
+  const vector<int> &order() const { return _vertex_at; }
+  const vector<int> &successors(int u) const { return _out[u]; }
+
+private:
+  void resize(int n) {
+    int old = num_vertices();
+    _ord.resize(n);
+    _vertex_at.resize(n);
+    _out.resize(n);
+    _in.resize(n);
+    _mark.resize(n, false);
+    for (int v = old; v < n; ++v)
+      _ord[v] = _vertex_at[v] = v;
+  }
+
+  // Iterative dfs from s through the edges of adj, only entering the
+  // vertices whose position satisfies inside(ord, bound).  The visited
+  // vertices are marked and collected in visited.  Returns false as soon
+  // as stop is reached.
+  template <class Inside>
+  bool search(int s, int bound, const vector<vector<int>> &adj,
+              vector<int> &visited, Inside inside, int stop) {
+    _stack.assign(1, s);
+    _mark[s] = true;
+    visited.push_back(s);
+    while (!_stack.empty()) {
+      int u = _stack.back();
+      _stack.pop_back();
+      for (int w : adj[u]) {
+        if (w == stop)
+          return false;
+        if (_mark[w] || !inside(_ord[w], bound))
+          continue;
+        _mark[w] = true;
+        visited.push_back(w);
+        _stack.push_back(w);
+      }
+    }
+    return true;
+  }
+
+  void reorder() {
+    auto by_position = [this](int a, int b) { return _ord[a] < _ord[b]; };
+    std::sort(_delta_b.begin(), _delta_b.end(), by_position);
+    std::sort(_delta_f.begin(), _delta_f.end(), by_position);
+    // the positions freed by both sets, in increasing order
+    _slots.clear();
+    for (int v : _delta_b)
+      _slots.push_back(_ord[v]);
+    for (int v : _delta_f)
+      _slots.push_back(_ord[v]);
+    std::sort(_slots.begin(), _slots.end());
+    // delta_b first, then delta_f
+    size_t i = 0;
+    for (int v : _delta_b) {
+      _mark[v] = false;
+      _ord[v] = _slots[i++];
+      _vertex_at[_ord[v]] = v;
+    }
+    for (int v : _delta_f) {
+      _mark[v] = false;
+      _ord[v] = _slots[i++];
+      _vertex_at[_ord[v]] = v;
+    }
+  }
+
+  vector<int> _ord;       // vertex -> position
+  vector<int> _vertex_at; // position -> vertex
+  vector<vector<int>> _out, _in;
+  // scratch space, kept between insertions to avoid reallocating
+  vector<bool> _mark;
+  vector<int> _delta_f, _delta_b, _slots, _stack;
+};
 }
 }
@@ -0,0 +1,49 @@
+// minimum spanning tree: Kruskal and Filter-Kruskal, see mst.hpp
+//
+// g++ kruskal-mst.cpp -std=c++14 -pthread
+
+#include "../../util/parallel.hpp"
+#include "../basics/csr.hpp"
+#include "../basics/generators.hpp"
+#include "mst.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+int main() {
+
+  // CLRS P.632 Figure 23.4, a..i are 0..8
+  vector<weighted_edge<int>> edges = {
+      {0, 1, 4}, {0, 7, 8}, {1, 2, 8}, {1, 7, 11}, {2, 3, 7},
+      {2, 5, 4}, {2, 8, 2}, {3, 4, 9}, {3, 5, 14}, {4, 5, 10},
+      {5, 6, 2}, {6, 7, 1}, {6, 8, 6}, {7, 8, 7}};
+  auto r = kruskal(9, edges);
+  assert(r.weight == 37 && r.edges.size() == 8);
+  for (auto &e : r.edges)
+    cout << char('a' + e.from) << "-" << char('a' + e.to) << " ";
+  cout << "weight: " << r.weight << "\n";
+  assert(filter_kruskal(9, edges).weight == 37);
+
+  // a random graph big enough for filter_kruskal to partition and filter
+  const int n = 1 << 14;
+  auto random_edges =
+      with_random_weights<long long>(rmat_edges(14, 16, 1), 1, 1000000, 2);
+  auto expected = kruskal(n, random_edges);
+  thread_pool pool(3);
+  for (auto f : {filter_kruskal(n, random_edges),
+                 filter_kruskal(n, random_edges, &pool),
+                 kruskal(n, random_edges, &pool)}) {
+    assert(f.weight == expected.weight);
+    assert(f.edges.size() == expected.edges.size());
+  }
+  auto f = filter_kruskal(n, random_edges);
+  cout << random_edges.size() << " edges, kruskal: " << expected.finds
+       << " finds, " << expected.steps << " steps, " << expected.unions
+       << " unions; filter-kruskal: " << f.finds << " finds, " << f.steps
+       << " steps, " << f.unions << " unions, " << f.filtered
+       << " edges filtered\n";
+}
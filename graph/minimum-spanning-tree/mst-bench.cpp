@@ -0,0 +1,79 @@
+// minimum spanning tree benchmark
+//
+// g++ mst-bench.cpp -std=c++14 -O2 -pthread
+// ./a.out [scale=18] [max threads=hardware threads]
+//
+// Inputs: R-MAT and Erdos-Renyi graphs with 2^scale vertices and
+// 16 * 2^scale edges, weights uniform in [1, 10^6].  Prim is timed on the
+// adjacency alone, building it is reported apart.
+
+#include "../../util/bench.hpp"
+#include "../../util/parallel.hpp"
+#include "../basics/csr.hpp"
+#include "../basics/generators.hpp"
+#include "mst.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+using W = long long;
+
+void report(const char *input, const string &algorithm,
+            const mst_result<W> &r, double t, size_t m) {
+  printf("%-12s %-24s %8.4f %10.2f %12zu %12zu %12zu %12zu\n", input,
+         algorithm.c_str(), t, m / t / 1e6, r.finds, r.steps, r.unions,
+         r.filtered);
+}
+
+int main(int argc, char **argv) {
+  int scale = argc > 1 ? atoi(argv[1]) : 18;
+  int max_threads = argc > 2 ? atoi(argv[2]) : hardware_threads();
+  int n = 1 << scale;
+  printf("%-12s %-24s %8s %10s %12s %12s %12s %12s\n", "input", "algorithm",
+         "seconds", "Medges/s", "finds", "steps", "unions", "filtered");
+  struct input {
+    const char *name;
+    vector<edge> edges;
+  };
+  vector<input> inputs = {{"rmat", rmat_edges(scale, 16, 1)},
+                          {"erdos-renyi", erdos_renyi_edges(n, 16LL * n, 2)}};
+  for (auto &in : inputs) {
+    auto edges = with_random_weights<W>(in.edges, 1, 1000000, 3);
+    mst_result<W> expected, r;
+    double t = best_time(3, [&] { expected = kruskal(n, edges); });
+    report(in.name, "kruskal", expected, t, edges.size());
+    t = best_time(3, [&] { r = filter_kruskal(n, edges); });
+    assert(r.weight == expected.weight);
+    report(in.name, "filter-kruskal", r, t, edges.size());
+    weighted_csr_graph<W> g;
+    t = best_time(3, [&] { g = undirected_graph(n, edges); });
+    printf("%-12s %-24s %8.4f\n", in.name, "(prim adjacency)", t);
+    t = best_time(3, [&] { r = prim(g); });
+    assert(r.weight == expected.weight);
+    report(in.name, "prim", r, t, edges.size());
+    for (int threads = 1;; threads = min(2 * threads, max_threads)) {
+      thread_pool pool(threads);
+      t = best_time(3, [&] { r = kruskal(n, edges, &pool); });
+      assert(r.weight == expected.weight);
+      report(in.name, "kruskal x" + to_string(threads), r, t, edges.size());
+      t = best_time(3, [&] { r = filter_kruskal(n, edges, &pool); });
+      assert(r.weight == expected.weight);
+      report(in.name, "filter-kruskal x" + to_string(threads), r, t,
+             edges.size());
+      t = best_time(3, [&] { r = boruvka(n, edges, pool); });
+      assert(r.weight == expected.weight);
+      report(in.name, "boruvka x" + to_string(threads) + " (" +
+                          to_string(r.rounds) + " rounds)",
+             r, t, edges.size());
+      if (threads == max_threads)
+        break;
+    }
+  }
+}
@@ -0,0 +1,371 @@
+// minimum spanning trees (CLRS 23)
+//
+// The input is an undirected graph given as a list of weighted edges, each
+// edge listed once (u, v, w) with 0 <= u, v < n.  If the graph isn't
+// connected the result is a minimum spanning forest.
+//
+// Kruskal (CLRS 23.2): take the edges by increasing weight and keep an edge
+// when its endpoints are in different trees of the forest built so far,
+// the trees being the sets of a disjoint-set forest.  The sort is most of
+// the work, O(E lgE).
+//
+// Filter-Kruskal (Osipov, Sanders and Singler): quicksort the edges, but
+// lazily.  Partition on a pivot weight, run on the light half first, then
+// before going on with the heavy half throw away its edges whose endpoints
+// already are in the same tree.  Those never get sorted.  On large
+// graphs the light part alone usually connects most of the vertices, and
+// most of the heavy edges are dropped by the filter.
+//
+// Prim (CLRS 23.2): grow a single tree from a root, always adding the
+// lightest edge leaving it.  The vertices not in the tree yet sit in a
+// priority queue keyed by the weight of their lightest edge to the tree,
+// lowered with decrease-key as the tree grows.  Runs on the adjacency
+// (weighted_csr_graph, see undirected_graph() in csr.hpp) with no sort at
+// all, O(E lgV) with a binary heap, which makes it the choice for dense
+// graphs.
+//
+// Boruvka: every component picks its lightest outgoing edge, all those
+// edges belong to the MST, the components they join are contracted, and
+// again.  The number of components at least halves every round, so there
+// are at most lgV rounds, and within a round everything is a parallel loop
+// over the edges or the components:
+//  1. each edge proposes itself to the components of its two endpoints,
+//     the lightest proposal is kept with an atomic compare-and-swap,
+//  2. each component hooks itself under the component at the other end of
+//     its lightest edge,
+//  3. pointer jumping flattens the hooks into stars, the roots name the
+//     new components,
+//  4. the edges are relabeled and those now inside a component dropped.
+// Ties are broken on the position of the edge in the input, so that the
+// edges picked never form a cycle; the only cycles among the hooks are two
+// components picking the same edge, the smaller one then stays a root.
+#pragma once
+
+#include "../../tree/disjoint-set/disjoint-set.hpp"
+#include "../../tree/heap/heap.hpp"
+#include "../../util/parallel.hpp"
+#include "../basics/csr.hpp"
+#include "../basics/graph.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::size_t;
+using std::vector;
+
+template <class W> class mst_result {
+public:
+  vector<weighted_edge<W>> edges; // n - (number of trees) edges
+  W weight = 0;
+  // union-find counters, see disjoint-set.hpp; for filter_kruskal finds
+  // and steps include the root_of lookups of the filter (two per edge)
+  size_t finds = 0, steps = 0, unions = 0, links = 0;
+  size_t filtered = 0; // edges dropped by the filter of filter_kruskal
+  int rounds = 0;       // boruvka rounds
+
+  void count(const tree::disjoint_set &ds) {
+    finds = ds.finds;
+    steps = ds.steps;
+    unions = ds.unions;
+    links = ds.links;
+  }
+};
+
+template <class W>
+bool lighter(const weighted_edge<W> &a, const weighted_edge<W> &b) {
+  return a.weight < b.weight;
+}
+
+// scans sorted edges into the forest
+template <class W, class It>
+void kruskal_scan(It first, It last, tree::disjoint_set &ds,
+                  mst_result<W> &r) {
+  for (auto it = first; it != last && ds.sets() > 1; ++it) {
+    if (ds.unite(it->from, it->to)) {
+      r.edges.push_back(*it);
+      r.weight += it->weight;
+    }
+  }
+}
+
+template <class W>
+mst_result<W> kruskal(int n, vector<weighted_edge<W>> edges,
+                      util::thread_pool *pool = nullptr) {
+  mst_result<W> r;
+  tree::disjoint_set ds(n);
+  if (pool)
+    util::parallel_sort(*pool, edges.begin(), edges.end(), lighter<W>);
+  else
+    std::sort(edges.begin(), edges.end(), lighter<W>);
+  kruskal_scan(edges.begin(), edges.end(), ds, r);
+  r.count(ds);
+  return r;
+}
+
+template <class W> class filter_kruskal_state {
+public:
+  filter_kruskal_state(int n, vector<weighted_edge<W>> &edges,
+                       util::thread_pool *pool)
+      : ds(n), edges(edges), pool(pool), rng(n),
+        threshold(std::max<size_t>(n, 1 << 12)) {}
+
+  void run(size_t first, size_t last) {
+    if (first == last || ds.sets() == 1)
+      return;
+    if (last - first <= threshold) {
+      sort(first, last);
+      return;
+    }
+    W pivot = pick_pivot(first, last);
+    size_t mid = partition(first, last, [pivot](const weighted_edge<W> &e) {
+      return e.weight < pivot;
+    });
+    if (mid == first) // nothing lighter than the pivot, split off the ties
+      mid = partition(first, last, [pivot](const weighted_edge<W> &e) {
+        return !(pivot < e.weight);
+      });
+    if (mid == last) { // all the same weight, order doesn't matter
+      kruskal_scan(edges.begin() + first, edges.begin() + last, ds, r);
+      return;
+    }
+    run(first, mid);
+    if (ds.sets() == 1)
+      return;
+    // filter: only keep the heavy edges joining two different trees, no
+    // union happens meanwhile so root_of can run in parallel.  The lookups
+    // are counted per call, one atomic add each.
+    size_t kept = partition(mid, last, [this](const weighted_edge<W> &e) {
+      size_t walked = 0;
+      bool apart = ds.root_of(e.from, walked) != ds.root_of(e.to, walked);
+      filter_steps.fetch_add(walked, std::memory_order_relaxed);
+      return apart;
+    });
+    filter_finds += 2 * (last - mid);
+    r.filtered += last - kept;
+    run(mid, kept);
+  }
+
+  // the counters of ds and of the filter
+  void count() {
+    r.count(ds);
+    r.finds += filter_finds;
+    r.steps += filter_steps.load();
+  }
+
+  mst_result<W> r;
+  tree::disjoint_set ds;
+
+private:
+  void sort(size_t first, size_t last) {
+    if (pool)
+      util::parallel_sort(*pool, edges.begin() + first, edges.begin() + last,
+                          lighter<W>);
+    else
+      std::sort(edges.begin() + first, edges.begin() + last, lighter<W>);
+    kruskal_scan(edges.begin() + first, edges.begin() + last, ds, r);
+  }
+
+  template <class Pred> size_t partition(size_t first, size_t last, Pred p) {
+    if (pool)
+      return util::parallel_partition(*pool, edges, first, last, p);
+    return std::partition(edges.begin() + first, edges.begin() + last, p) -
+           edges.begin();
+  }
+
+  // median of a small random sample
+  W pick_pivot(size_t first, size_t last) {
+    std::uniform_int_distribution<size_t> pick(first, last - 1);
+    W sample[9];
+    for (auto &w : sample)
+      w = edges[pick(rng)].weight;
+    std::nth_element(sample, sample + 4, sample + 9);
+    return sample[4];
+  }
+
+  vector<weighted_edge<W>> &edges;
+  util::thread_pool *pool;
+  std::mt19937_64 rng;
+  size_t threshold; // below this many edges, sort and scan
+  size_t filter_finds = 0;
+  std::atomic<size_t> filter_steps{0};
+};
+
+template <class W>
+mst_result<W> filter_kruskal(int n, vector<weighted_edge<W>> edges,
+                             util::thread_pool *pool = nullptr) {
+  filter_kruskal_state<W> state(n, edges, pool);
+  state.run(0, edges.size());
+  state.count();
+  return state.r;
+}
+
+// Prim on every connected component in turn, the Queue is an indexed heap
+// as for dijkstra (see sssp.hpp)
+template <class Queue, class G>
+mst_result<typename G::weight_type> prim(const G &g) {
+  using W = typename G::weight_type;
+  const int n = num_vertices(g);
+  mst_result<W> r;
+  Queue q(n);
+  vector<W> key(n);
+  vector<int> parent(n, -1);
+  vector<bool> in_tree(n, false);
+  for (int root = 0; root < n; ++root) {
+    if (in_tree[root])
+      continue;
+    key[root] = 0;
+    q.push(root, 0);
+    while (!q.empty()) {
+      int u = q.pop();
+      in_tree[u] = true;
+      if (parent[u] >= 0) {
+        r.edges.push_back(weighted_edge<W>{parent[u], u, key[u]});
+        r.weight += key[u];
+      }
+      for (auto a : out_edges(g, u)) {
+        if (in_tree[a.to])
+          continue;
+        if (!q.contains(a.to)) {
+          key[a.to] = a.weight;
+          parent[a.to] = u;
+          q.push(a.to, a.weight);
+        } else if (a.weight < key[a.to]) {
+          key[a.to] = a.weight;
+          parent[a.to] = u;
+          q.decrease_key(a.to, a.weight);
+        }
+      }
+    }
+  }
+  return r;
+}
+
+template <class G> mst_result<typename G::weight_type> prim(const G &g) {
+  return prim<tree::indexed_binary_heap<typename G::weight_type>>(g);
+}
+
+template <class W>
+mst_result<W> boruvka(int n, const vector<weighted_edge<W>> &input,
+                      util::thread_pool &pool) {
+  const size_t none = std::numeric_limits<size_t>::max();
+  const int threads = pool.size();
+  // the edges still between two components: the components of their
+  // endpoints and the position of the edge in the input
+  struct link {
+    int u, v;
+    size_t id;
+  };
+  vector<link> links;
+  links.reserve(input.size());
+  for (size_t i = 0; i < input.size(); ++i)
+    if (input[i].from != input[i].to)
+      links.push_back(link{input[i].from, input[i].to, i});
+  // lighter, ties broken on the position
+  auto lighter_id = [&](size_t a, size_t b) {
+    return input[a].weight < input[b].weight ||
+           (!(input[b].weight < input[a].weight) && a < b);
+  };
+
+  mst_result<W> r;
+  vector<std::atomic<size_t>> best(n);
+  vector<std::atomic<int>> parent(n);
+  vector<vector<size_t>> picked(threads);
+  vector<int> label(n); // component of each vertex
+  for (int v = 0; v < n; ++v)
+    label[v] = v;
+
+  while (!links.empty()) {
+    ++r.rounds;
+    util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+      for (auto c = lo; c < hi; ++c) {
+        best[c].store(none, std::memory_order_relaxed);
+        parent[c].store(static_cast<int>(c), std::memory_order_relaxed);
+      }
+    });
+    // 1. the lightest edge out of each component
+    auto propose = [&](int c, size_t id) {
+      size_t cur = best[c].load(std::memory_order_relaxed);
+      while ((cur == none || lighter_id(id, cur)) &&
+             !best[c].compare_exchange_weak(cur, id,
+                                            std::memory_order_relaxed))
+        ;
+    };
+    util::parallel_for(pool, 0, links.size(), [&](size_t lo, size_t hi, int) {
+      for (auto i = lo; i < hi; ++i) {
+        propose(links[i].u, links[i].id);
+        propose(links[i].v, links[i].id);
+      }
+    });
+    // 2. hook, the component owning the edge records it
+    util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int tid) {
+      for (auto c = lo; c < hi; ++c) {
+        size_t id = best[c].load(std::memory_order_relaxed);
+        if (id == none)
+          continue;
+        int a = label[input[id].from], b = label[input[id].to];
+        int other = a == static_cast<int>(c) ? b : a;
+        if (best[other].load(std::memory_order_relaxed) == id &&
+            static_cast<int>(c) < other)
+          continue; // both picked this edge, c stays a root
+        parent[c].store(other, std::memory_order_relaxed);
+        picked[tid].push_back(id);
+      }
+    });
+    for (auto &p : picked) {
+      for (auto id : p) {
+        r.edges.push_back(input[id]);
+        r.weight += input[id].weight;
+      }
+      p.clear();
+    }
+    // 3. pointer jumping until every component points at its root
+    for (bool changed = true; changed;) {
+      std::atomic<bool> any(false);
+      util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+        bool mine = false;
+        for (auto c = lo; c < hi; ++c) {
+          int p = parent[c].load(std::memory_order_relaxed),
+              pp = parent[p].load(std::memory_order_relaxed);
+          if (p != pp) {
+            parent[c].store(pp, std::memory_order_relaxed);
+            mine = true;
+          }
+        }
+        if (mine)
+          any.store(true, std::memory_order_relaxed);
+      });
+      changed = any.load();
+    }
+    // 4. contract
+    util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+      for (auto v = lo; v < hi; ++v)
+        label[v] = parent[label[v]].load(std::memory_order_relaxed);
+    });
+    util::parallel_for(pool, 0, links.size(), [&](size_t lo, size_t hi, int) {
+      for (auto i = lo; i < hi; ++i) {
+        links[i].u = parent[links[i].u].load(std::memory_order_relaxed);
+        links[i].v = parent[links[i].v].load(std::memory_order_relaxed);
+      }
+    });
+    size_t kept = util::parallel_partition(
+        pool, links, 0, links.size(),
+        [](const link &l) { return l.u != l.v; });
+    links.resize(kept);
+  }
+  return r;
+}
+
+template <class W>
+mst_result<W> boruvka(int n, const vector<weighted_edge<W>> &edges,
+                      int threads) {
+  util::thread_pool pool(threads);
+  return boruvka(n, edges, pool);
+}
+}
+}
@@ -0,0 +1,52 @@
+// minimum spanning tree: Prim and Boruvka, see mst.hpp
+//
+// g++ prim-mst.cpp -std=c++14 -pthread
+
+#include "../../util/parallel.hpp"
+#include "../basics/csr.hpp"
+#include "../basics/generators.hpp"
+#include "mst.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+int main() {
+
+  // CLRS P.635 Figure 23.5, the graph of Figure 23.4, a..i are 0..8
+  vector<weighted_edge<int>> edges = {
+      {0, 1, 4}, {0, 7, 8}, {1, 2, 8}, {1, 7, 11}, {2, 3, 7},
+      {2, 5, 4}, {2, 8, 2}, {3, 4, 9}, {3, 5, 14}, {4, 5, 10},
+      {5, 6, 2}, {6, 7, 1}, {6, 8, 6}, {7, 8, 7}};
+  auto r = prim(undirected_graph(9, edges));
+  assert(r.weight == 37 && r.edges.size() == 8);
+  // Prim grows the tree from a
+  for (auto &e : r.edges)
+    cout << char('a' + e.from) << "-" << char('a' + e.to) << " ";
+  cout << "weight: " << r.weight << "\n";
+  auto b = boruvka(9, edges, 2);
+  assert(b.weight == 37 && b.edges.size() == 8);
+  cout << "boruvka: " << b.rounds << " rounds\n";
+
+  // many equal weights, the tie-break has to keep the picks acyclic
+  const int n = 1 << 14;
+  for (int hi : {4, 1000000}) {
+    auto random_edges =
+        with_random_weights<long long>(rmat_edges(14, 16, 1), 1, hi, 2);
+    auto expected = kruskal(n, random_edges);
+    auto p = prim(undirected_graph(n, random_edges));
+    assert(p.weight == expected.weight);
+    assert(p.edges.size() == expected.edges.size());
+    for (int threads : {1, 3}) {
+      auto f = boruvka(n, random_edges, threads);
+      assert(f.weight == expected.weight);
+      assert(f.edges.size() == expected.edges.size());
+    }
+    cout << random_edges.size() << " edges, weights in [1, " << hi
+         << "]: weight " << expected.weight << ", boruvka "
+         << boruvka(n, random_edges, 3).rounds << " rounds\n";
+  }
+}
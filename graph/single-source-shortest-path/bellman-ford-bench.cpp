@@ -0,0 +1,71 @@
+// Bellman-Ford benchmark: rounds, relaxations and time of each mode
+//
+// g++ bellman-ford-bench.cpp -std=c++14 -O2 -pthread
+// ./a.out [scale=16] [max threads=hardware threads]
+//
+// Input: R-MAT and Erdos-Renyi graphs with 2^scale vertices
+// and 8 * 2^scale edges, weights in [0, 100] shifted by a random potential
+// so that a third of them are negative but no cycle is.
+
+#include "../../util/bench.hpp"
+#include "../../util/parallel.hpp"
+#include "../basics/csr.hpp"
+#include "../basics/generators.hpp"
+#include "bellman-ford.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::util;
+
+using W = long long;
+
+void report(const char *input, const string &mode,
+            const bellman_ford_result<W> &r, double t) {
+  printf("%-12s %-12s %8.4f %8d %14zu %14zu\n", input, mode.c_str(), t,
+         r.rounds, r.relaxations, r.improvements);
+}
+
+int main(int argc, char **argv) {
+  int scale = argc > 1 ? atoi(argv[1]) : 16;
+  int max_threads = argc > 2 ? atoi(argv[2]) : hardware_threads();
+  int n = 1 << scale;
+  printf("%-12s %-12s %8s %8s %14s %14s\n", "input", "mode", "seconds",
+         "rounds", "relaxations", "improvements");
+  struct input {
+    const char *name;
+    vector<edge> edges;
+  };
+  vector<input> inputs = {{"rmat", rmat_edges(scale, 8, 1)},
+                          {"erdos-renyi", erdos_renyi_edges(n, 8LL * n, 2)}};
+  mt19937 rng(3);
+  vector<W> p(n);
+  for (auto &x : p)
+    x = rng() % 100;
+  for (auto &in : inputs) {
+    auto edges = with_random_weights<W>(in.edges, 0, 100, 4);
+    for (auto &e : edges)
+      e.weight += p[e.from] - p[e.to];
+    weighted_csr_graph<W> g(n, edges);
+    bellman_ford_result<W> expected, r;
+    double t = best_time(1, [&] { expected = bellman_ford(g, 0); });
+    report(in.name, "rounds", expected, t);
+    t = best_time(1, [&] { r = queue_bellman_ford(g, 0); });
+    assert(r.dist == expected.dist);
+    report(in.name, "queue", r, t);
+    for (int threads = 1;; threads = min(2 * threads, max_threads)) {
+      thread_pool pool(threads);
+      t = best_time(1, [&] { r = parallel_bellman_ford(g, 0, pool); });
+      assert(r.dist == expected.dist);
+      report(in.name, "parallel x" + to_string(threads), r, t);
+      if (threads == max_threads)
+        break;
+    }
+  }
+}
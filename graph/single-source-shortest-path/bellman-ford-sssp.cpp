@@ -0,0 +1,114 @@
+// single-source shortest paths with negative weights: Bellman-Ford, see
+// bellman-ford.hpp
+//
+// g++ bellman-ford-sssp.cpp -std=c++14 -pthread
+
+#include "../basics/csr.hpp"
+#include "../basics/generators.hpp"
+#include "bellman-ford.hpp"
+#include "sssp.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+
+// the cycle is one and its weight is negative
+template <class G>
+bool is_negative_cycle(const G &g, const vector<int> &cycle) {
+  long long total = 0;
+  for (size_t i = 0; i < cycle.size(); ++i) {
+    int u = cycle[i], v = cycle[(i + 1) % cycle.size()];
+    bool found = false;
+    long long best = 0;
+    for (auto a : out_edges(g, u))
+      if (a.to == v && (!found || a.weight < best)) {
+        best = a.weight;
+        found = true;
+      }
+    if (!found)
+      return false;
+    total += best;
+  }
+  return !cycle.empty() && total < 0;
+}
+
+int main() {
+
+  // CLRS P.652 Figure 24.4, s t x y z are 0 1 2 3 4
+  weighted_csr_graph<int> g(5, {{0, 1, 6},
+                                {0, 3, 7},
+                                {1, 2, 5},
+                                {1, 3, 8},
+                                {1, 4, -4},
+                                {2, 1, -2},
+                                {3, 2, -3},
+                                {3, 4, 9},
+                                {4, 0, 2},
+                                {4, 2, 7}});
+  vector<int> expected = {0, 2, 4, 7, -2};
+  vector<bellman_ford_result<int>> results = {
+      bellman_ford(g, 0), queue_bellman_ford(g, 0),
+      parallel_bellman_ford(g, 0, 2)};
+  const char *modes[] = {"rounds", "queue", "parallel"};
+  for (int i = 0; i < 3; ++i) {
+    auto &r = results[i];
+    assert(r.dist == expected && !r.has_negative_cycle());
+    cout << modes[i] << ": " << r.rounds << " rounds, " << r.relaxations
+         << " relaxations, " << r.improvements << " improvements\n";
+  }
+
+  // z -> x weighs -7 instead of 7: x t z x weighs -2 - 4 - 7 < 0
+  weighted_csr_graph<int> cyclic(5, {{0, 1, 6},
+                                     {0, 3, 7},
+                                     {1, 2, 5},
+                                     {1, 3, 8},
+                                     {1, 4, -4},
+                                     {2, 1, -2},
+                                     {3, 2, -3},
+                                     {3, 4, 9},
+                                     {4, 0, 2},
+                                     {4, 2, -7}});
+  for (auto r : {bellman_ford(cyclic, 0), queue_bellman_ford(cyclic, 0),
+                 parallel_bellman_ford(cyclic, 0, 2)}) {
+    assert(is_negative_cycle(cyclic, r.negative_cycle));
+    cout << "negative cycle:";
+    for (int v : r.negative_cycle)
+      cout << " " << "stxyz"[v];
+    cout << "\n";
+  }
+
+  // negative weights without negative cycles: w(u, v) + p(u) - p(v) for
+  // non-negative w and any potential p.  Every cycle keeps its weight and
+  // the distances are those of Dijkstra on w, shifted by p(s) - p(v).
+  const int n = 1 << 12;
+  mt19937 rng(3);
+  vector<long long> p(n);
+  for (auto &x : p)
+    x = rng() % 1000;
+  auto edges = with_random_weights<long long>(rmat_edges(12, 8, 8), 0, 100, 9);
+  weighted_csr_graph<long long> positive(n, edges);
+  for (auto &e : edges)
+    e.weight += p[e.from] - p[e.to];
+  weighted_csr_graph<long long> shifted(n, edges);
+  auto reference = dijkstra(positive, 0);
+  for (int threads = 1; threads <= 3; ++threads) {
+    for (auto r : {bellman_ford(shifted, 0), queue_bellman_ford(shifted, 0),
+                   parallel_bellman_ford(shifted, 0, threads)}) {
+      assert(!r.has_negative_cycle());
+      for (int v = 0; v < n; ++v)
+        assert(r.reached(v) == reference.reached(v) &&
+               (!r.reached(v) || r.dist[v] == reference.dist[v] + p[0] - p[v]));
+    }
+  }
+  // and the same with a negative cycle planted far from the source
+  edges.push_back({n - 1, n - 2, -1});
+  edges.push_back({n - 2, n - 1, -1});
+  edges.push_back({0, n - 1, 0});
+  weighted_csr_graph<long long> planted(n, edges);
+  for (auto r : {bellman_ford(planted, 0), queue_bellman_ford(planted, 0),
+                 parallel_bellman_ford(planted, 0, 2)})
+    assert(is_negative_cycle(planted, r.negative_cycle));
+}
@@ -0,0 +1,262 @@
+// Bellman-Ford (CLRS 24.1), shortest paths with negative weights
+//
+// Every round relaxes edges, a round that changes nothing means the
+// distances are final and we can stop there instead of doing all the V-1
+// rounds of CLRS.  A change still happening after V-1 rounds means a
+// negative cycle is reachable from the source, then the distances make no
+// sense and the result holds the cycle itself.
+//
+// Three ways of running the rounds:
+//  bellman_ford: the CLRS way, a round relaxes every edge.
+//  queue_bellman_ford: (SPFA) only the edges out of the vertices whose
+//    distance changed since they were last scanned, kept in a FIFO queue.
+//    A "round" is one generation of the queue.
+//  parallel_bellman_ford: the edges in one flat array grouped by target
+//    vertex (an in-edge CSR), the targets split among the threads.  A
+//    vertex is only ever written by the thread owning it, which takes the
+//    minimum over its in-edges, so no lock or CAS is needed.
+//
+// The cycle: a cycle in the parent graph is always a negative cycle (every
+// parent edge was tight when it was set and the distances only went down
+// since), and once a negative cycle keeps the rounds going one eventually
+// shows up in the parent graph.  So after V rounds, or every V relaxations
+// for the queue version, we look for a cycle in the parent graph.
+#pragma once
+
+#include "../../util/parallel.hpp"
+#include "../basics/csr.hpp"
+#include "../basics/graph.hpp"
+#include "sssp.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::size_t;
+using std::vector;
+
+template <class W> class bellman_ford_result : public sssp_result<W> {
+public:
+  bellman_ford_result() {}
+  bellman_ford_result(int n, int source) : sssp_result<W>(n, source) {}
+  bool has_negative_cycle() const { return !negative_cycle.empty(); }
+
+  // the vertices of a negative cycle in edge order (the last one has an
+  // edge to the first one), empty if there's none
+  vector<int> negative_cycle;
+  int rounds = 0;
+  size_t relaxations = 0; // edges relaxed
+  size_t improvements = 0; // relaxations that lowered a distance
+};
+
+// A cycle of the parent graph, empty if there's none.  Every vertex has at
+// most one parent, so each chain of parents is followed once: O(V).
+inline vector<int> parent_cycle(const vector<int> &parent) {
+  const int n = static_cast<int>(parent.size());
+  vector<int> seen(n, -1), cycle; // seen[v]: the start of the walk seeing v
+  for (int start = 0; start < n; ++start) {
+    int v = start;
+    while (v >= 0 && seen[v] < 0) {
+      seen[v] = start;
+      v = parent[v];
+    }
+    if (v < 0 || seen[v] != start)
+      continue; // reached the root or an older walk
+    // v is on a cycle, walk it once more, backwards along the edges
+    int u = v;
+    do {
+      cycle.push_back(u);
+      u = parent[u];
+    } while (u != v);
+    std::reverse(cycle.begin(), cycle.end());
+    return cycle;
+  }
+  return cycle;
+}
+
+template <class G>
+bellman_ford_result<typename G::weight_type> bellman_ford(const G &g, int s) {
+  using W = typename G::weight_type;
+  const int n = num_vertices(g);
+  assert(s < n);
+  bellman_ford_result<W> r(n, s);
+  r.dist[s] = 0;
+  for (bool changed = true; changed;) {
+    changed = false;
+    ++r.rounds;
+    for (int u = 0; u < n; ++u) {
+      if (!r.reached(u))
+        continue;
+      for (auto a : out_edges(g, u)) {
+        ++r.relaxations;
+        W d = r.dist[u] + a.weight;
+        if (d < r.dist[a.to]) {
+          r.dist[a.to] = d;
+          r.parent[a.to] = u;
+          ++r.improvements;
+          changed = true;
+        }
+      }
+    }
+    if (changed && r.rounds >= n) {
+      r.negative_cycle = parent_cycle(r.parent);
+      if (r.has_negative_cycle())
+        break;
+    }
+  }
+  return r;
+}
+
+template <class G>
+bellman_ford_result<typename G::weight_type> queue_bellman_ford(const G &g,
+                                                                int s) {
+  using W = typename G::weight_type;
+  const int n = num_vertices(g);
+  assert(s < n);
+  bellman_ford_result<W> r(n, s);
+  vector<bool> queued(n, false);
+  std::deque<int> fifo;
+  r.dist[s] = 0;
+  fifo.push_back(s);
+  queued[s] = true;
+  size_t since_check = 0;
+  while (!fifo.empty()) {
+    ++r.rounds;
+    // one generation: the vertices queued during the previous one
+    for (size_t generation = fifo.size(); generation > 0; --generation) {
+      int u = fifo.front();
+      fifo.pop_front();
+      queued[u] = false;
+      for (auto a : out_edges(g, u)) {
+        ++r.relaxations;
+        W d = r.dist[u] + a.weight;
+        if (d >= r.dist[a.to])
+          continue;
+        r.dist[a.to] = d;
+        r.parent[a.to] = u;
+        ++r.improvements;
+        if (!queued[a.to]) {
+          queued[a.to] = true;
+          fifo.push_back(a.to);
+        }
+        if (++since_check >= static_cast<size_t>(n)) {
+          since_check = 0;
+          r.negative_cycle = parent_cycle(r.parent);
+          if (r.has_negative_cycle())
+            return r;
+        }
+      }
+    }
+  }
+  return r;
+}
+
+// the edges of g grouped by target vertex, for parallel_bellman_ford
+template <class W> class in_edge_array {
+public:
+  template <class G> explicit in_edge_array(const G &g) {
+    const int n = num_vertices(g);
+    offsets.assign(n + 1, 0);
+    for (int u = 0; u < n; ++u)
+      for (auto a : out_edges(g, u))
+        ++offsets[a.to + 1];
+    for (int v = 0; v < n; ++v)
+      offsets[v + 1] += offsets[v];
+    sources.resize(offsets[n]);
+    weights.resize(offsets[n]);
+    vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (int u = 0; u < n; ++u)
+      for (auto a : out_edges(g, u)) {
+        auto i = next[a.to]++;
+        sources[i] = u;
+        weights[i] = a.weight;
+      }
+  }
+
+  vector<size_t> offsets; // the in-edges of v: [offsets[v], offsets[v+1])
+  vector<int> sources;
+  vector<W> weights;
+};
+
+template <class G>
+bellman_ford_result<typename G::weight_type>
+parallel_bellman_ford(const G &g, int s, util::thread_pool &pool) {
+  using W = typename G::weight_type;
+  const int n = num_vertices(g), threads = pool.size();
+  assert(s < n);
+  const W inf = sssp_result<W>::infinity();
+  in_edge_array<W> in(g);
+  bellman_ford_result<W> r(n, s);
+  vector<std::atomic<W>> dist(n);
+  for (int v = 0; v < n; ++v)
+    dist[v].store(v == s ? 0 : inf, std::memory_order_relaxed);
+  vector<size_t> relaxations(threads), improvements(threads);
+  for (bool changed = true; changed;) {
+    std::atomic<bool> any(false);
+    ++r.rounds;
+    // split the vertices so that the threads get about the same number of
+    // in-edges rather than the same number of vertices
+    pool.run([&](int tid) {
+      size_t first_edge = in.offsets[n] * tid / threads,
+             last_edge = in.offsets[n] * (tid + 1) / threads;
+      int lo = std::lower_bound(in.offsets.begin(), in.offsets.end() - 1,
+                                first_edge) -
+               in.offsets.begin(),
+          hi = std::lower_bound(in.offsets.begin(), in.offsets.end() - 1,
+                                last_edge) -
+               in.offsets.begin();
+      if (tid == threads - 1)
+        hi = n;
+      bool mine = false;
+      for (int v = lo; v < hi; ++v) {
+        W best = dist[v].load(std::memory_order_relaxed);
+        int parent = -1;
+        for (auto i = in.offsets[v]; i < in.offsets[v + 1]; ++i) {
+          W du = dist[in.sources[i]].load(std::memory_order_relaxed);
+          if (du == inf)
+            continue;
+          ++relaxations[tid];
+          if (du + in.weights[i] < best) {
+            best = du + in.weights[i];
+            parent = in.sources[i];
+          }
+        }
+        if (parent >= 0) {
+          dist[v].store(best, std::memory_order_relaxed);
+          r.parent[v] = parent;
+          ++improvements[tid];
+          mine = true;
+        }
+      }
+      if (mine)
+        any.store(true, std::memory_order_relaxed);
+    });
+    changed = any.load();
+    if (changed && r.rounds >= n) {
+      r.negative_cycle = parent_cycle(r.parent);
+      if (r.has_negative_cycle())
+        break;
+    }
+  }
+  for (int v = 0; v < n; ++v)
+    r.dist[v] = dist[v].load(std::memory_order_relaxed);
+  for (int t = 0; t < threads; ++t) {
+    r.relaxations += relaxations[t];
+    r.improvements += improvements[t];
+  }
+  return r;
+}
+
+template <class G>
+bellman_ford_result<typename G::weight_type>
+parallel_bellman_ford(const G &g, int s, int threads) {
+  util::thread_pool pool(threads);
+  return parallel_bellman_ford(g, s, pool);
+}
+}
+}
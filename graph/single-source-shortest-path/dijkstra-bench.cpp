@@ -0,0 +1,111 @@
+// Dijkstra benchmark: the same graphs and sources with each priority queue,
+// then delta-stepping on 1..N threads, then the DAG shortest paths
+//
+// g++ dijkstra-bench.cpp -std=c++14 -O2 -pthread
+// ./a.out [scale=18] [max threads=hardware threads]
+//
+// Inputs: an undirected R-MAT and an Erdos-Renyi graph with 2^scale
+// vertices and 8 * 2^scale edges each way, with weights uniform in [1, 10]
+// (many ties, small key range) and in [1, 10^6].  Delta-stepping uses the
+// average weight as bucket width.
+
+#include "../../tree/heap/heap.hpp"
+#include "../../tree/heap/radix-heap.hpp"
+#include "../../util/bench.hpp"
+#include "../../util/parallel.hpp"
+#include "../basics/csr.hpp"
+#include "../basics/generators.hpp"
+#include "sssp.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::tree;
+using namespace clrs::util;
+
+using W = long long;
+
+template <class Queue>
+void run(const char *queue, const string &input,
+         const weighted_csr_graph<W> &g, const vector<int> &sources,
+         const vector<sssp_result<W>> &expected) {
+  vector<sssp_result<W>> results(sources.size());
+  double t = best_time(3, [&] {
+    for (size_t i = 0; i < sources.size(); ++i)
+      results[i] = dijkstra<Queue>(g, sources[i]);
+  });
+  for (size_t i = 0; i < sources.size(); ++i)
+    assert(results[i].dist == expected[i].dist);
+  printf("%-22s %-12s %10.4f %12.2f\n", input.c_str(), queue,
+         t / sources.size(), g.num_edges() * sources.size() / t / 1e6);
+}
+
+int main(int argc, char **argv) {
+  int scale = argc > 1 ? atoi(argv[1]) : 18;
+  int max_threads = argc > 2 ? atoi(argv[2]) : hardware_threads();
+  int n = 1 << scale;
+  printf("%-22s %-12s %10s %12s\n", "input", "queue", "seconds", "Medges/s");
+  struct input {
+    string name;
+    vector<edge> edges;
+  };
+  vector<input> inputs = {
+      {"rmat", symmetrize(rmat_edges(scale, 8, 1))},
+      {"erdos-renyi", symmetrize(erdos_renyi_edges(n, 8LL * n, 2))}};
+  for (auto &in : inputs) {
+    for (W max_weight : {W(10), W(1000000)}) {
+      weighted_csr_graph<W> g(n, with_random_weights<W>(in.edges, 1,
+                                                         max_weight, 3));
+      vector<int> sources;
+      for (int i = 0; i < 4; ++i)
+        sources.push_back((i * 7919) % n);
+      vector<sssp_result<W>> expected;
+      for (int s : sources)
+        expected.push_back(dijkstra(g, s));
+      auto name = in.name + " w<=" + to_string(max_weight);
+      run<indexed_binary_heap<W>>("binary", name, g, sources, expected);
+      run<indexed_heap<W, 4>>("4-ary", name, g, sources, expected);
+      run<indexed_heap<W, 8>>("8-ary", name, g, sources, expected);
+      run<radix_heap<W>>("radix", name, g, sources, expected);
+      for (int threads = 1;; threads = min(2 * threads, max_threads)) {
+        thread_pool pool(threads);
+        vector<sssp_result<W>> results(sources.size());
+        double t = best_time(3, [&] {
+          for (size_t i = 0; i < sources.size(); ++i)
+            results[i] =
+                delta_stepping(g, sources[i], (max_weight + 1) / 2, pool);
+        });
+        for (size_t i = 0; i < sources.size(); ++i)
+          assert(results[i].dist == expected[i].dist);
+        auto queue = "delta x" + to_string(threads);
+        printf("%-22s %-12s %10.4f %12.2f\n", name.c_str(), queue.c_str(),
+               t / sources.size(), g.num_edges() * sources.size() / t / 1e6);
+        if (threads == max_threads)
+          break;
+      }
+    }
+  }
+
+  // a DAG: edges of the R-MAT graph oriented from the lower to the higher
+  // id, topological order against Dijkstra
+  vector<weighted_edge<W>> dag_edges;
+  for (auto &e : with_random_weights<W>(rmat_edges(scale, 8, 4), 1, 1000, 5))
+    if (e.from != e.to)
+      dag_edges.push_back(
+          weighted_edge<W>{min(e.from, e.to), max(e.from, e.to), e.weight});
+  weighted_csr_graph<W> dag(n, dag_edges);
+  sssp_result<W> by_dijkstra, by_order;
+  double t_dijkstra = best_time(3, [&] { by_dijkstra = dijkstra(dag, 0); });
+  double t_order = best_time(3, [&] { by_order = dag_shortest_paths(dag, 0); });
+  assert(by_dijkstra.dist == by_order.dist);
+  printf("%-22s %-12s %10.4f %12.2f\n", "rmat dag", "binary", t_dijkstra,
+         dag.num_edges() / t_dijkstra / 1e6);
+  printf("%-22s %-12s %10.4f %12.2f\n", "rmat dag", "topological", t_order,
+         dag.num_edges() / t_order / 1e6);
+}
@@ -0,0 +1,121 @@
+// single-source shortest paths: Dijkstra, DAG shortest paths and
+// delta-stepping, see sssp.hpp
+//
+// g++ dijkstra-dag-sssp.cpp -std=c++14 -pthread
+
+#include "../../tree/heap/heap.hpp"
+#include "../../tree/heap/radix-heap.hpp"
+#include "../basics/csr.hpp"
+#include "../basics/generators.hpp"
+#include "sssp.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::tree;
+
+// every reached vertex but the source has a parent with a tight edge to it
+// and following the parents always leads back to the source
+template <class G, class W>
+bool is_shortest_path_tree(const G &g, const sssp_result<W> &r) {
+  for (int v = 0; v < num_vertices(g); ++v) {
+    if (!r.reached(v) || v == r.source)
+      continue;
+    int p = r.parent[v];
+    if (p < 0)
+      return false;
+    bool tight = false;
+    for (auto a : out_edges(g, p))
+      tight = tight || (a.to == v && r.dist[p] + a.weight == r.dist[v]);
+    if (!tight)
+      return false;
+    int hops = 0;
+    for (int u = v; u != r.source; u = r.parent[u])
+      if (u < 0 || ++hops > num_vertices(g))
+        return false;
+  }
+  return true;
+}
+
+int main() {
+
+  // CLRS P.659 Figure 24.6, s t x y z are 0 1 2 3 4
+  weighted_csr_graph<int> g(5, {{0, 1, 10},
+                                {0, 3, 5},
+                                {1, 2, 1},
+                                {1, 3, 2},
+                                {2, 4, 4},
+                                {3, 1, 3},
+                                {3, 2, 9},
+                                {3, 4, 2},
+                                {4, 0, 7},
+                                {4, 2, 6}});
+  vector<int> expected = {0, 8, 9, 5, 7};
+  vector<sssp_result<int>> results = {
+      dijkstra(g, 0), dijkstra<indexed_heap<int, 4>>(g, 0),
+      dijkstra<radix_heap<int>>(g, 0)};
+  for (auto &r : results) {
+    assert(r.dist == expected);
+    assert(r.parent == results[0].parent);
+  }
+  const char *names = "stxyz";
+  for (int v = 0; v < 5; ++v) {
+    cout << names[v] << ": " << results[0].dist[v] << ", path:";
+    for (int u = v; u >= 0; u = results[0].parent[u])
+      cout << " " << names[u];
+    cout << "\n";
+  }
+
+  // CLRS P.656 Figure 24.5, r s t x y z are 0 1 2 3 4 5
+  weighted_csr_graph<int> dag(6, {{0, 1, 5},
+                                  {0, 2, 3},
+                                  {1, 2, 2},
+                                  {1, 3, 6},
+                                  {2, 3, 7},
+                                  {2, 4, 4},
+                                  {2, 5, 2},
+                                  {3, 4, -1},
+                                  {3, 5, 1},
+                                  {4, 5, -2}});
+  auto dr = dag_shortest_paths(dag, 1);
+  assert(!dr.reached(0));
+  assert((vector<int>(dr.dist.begin() + 1, dr.dist.end()) ==
+          vector<int>{0, 2, 6, 5, 3}));
+  try {
+    dag_shortest_paths(g, 0); // figure 24.6 has cycles
+    assert(false);
+  } catch (const cycle_error &) {
+  }
+
+  // a random DAG (edges from lower to higher ids) must agree with Dijkstra
+  const int n = 5000;
+  mt19937 rng(11);
+  vector<weighted_edge<long long>> dag_edges;
+  for (int i = 0; i < 8 * n; ++i) {
+    int u = rng() % n, v = rng() % n;
+    if (u != v)
+      dag_edges.push_back({min(u, v), max(u, v), (long long)(rng() % 100)});
+  }
+  weighted_csr_graph<long long> random_dag(n, dag_edges);
+  assert(dag_shortest_paths(random_dag, 0).dist ==
+         dijkstra(random_dag, 0).dist);
+
+  // delta-stepping, whatever the bucket width and the number of threads
+  weighted_csr_graph<long long> rg(
+      1 << 12, with_random_weights<long long>(
+                   symmetrize(rmat_edges(12, 8, 5)), 0, 1000, 6));
+  counting_observer heap_ops;
+  auto expected_rg = dijkstra(rg, 0, heap_ops);
+  // each vertex reached is pushed and popped once
+  assert(heap_ops.pushes == heap_ops.pops &&
+         heap_ops.pops == heap_ops.discovered);
+  for (long long delta : {1, 100, 1000000})
+    for (int threads = 1; threads <= 3; ++threads) {
+      auto r = delta_stepping(rg, 0, delta, threads);
+      assert(r.dist == expected_rg.dist);
+      assert(is_shortest_path_tree(rg, r));
+    }
+}
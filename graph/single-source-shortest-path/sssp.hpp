@@ -0,0 +1,290 @@
+// single-source shortest paths (CLRS 24)
+//
+// All the algorithms here run on weighted graphs providing, on top of
+// num_vertices() (see graph.hpp):
+//   out_edges(g, u) -> a range of arc<W> {to, weight}
+// and a weight_type, like weighted_csr_graph<W> in csr.hpp.
+//
+// Their result is an sssp_result: dist[v] and parent[v] indexed by vertex,
+// dist[v] == sssp_result::infinity() when v isn't reachable.
+#pragma once
+
+#include "../../tree/heap/heap.hpp"
+#include "../../util/parallel.hpp"
+#include "../basics/csr.hpp"
+#include "../basics/graph.hpp"
+#include "../basics/observer.hpp"
+#include "../basics/toposort.hpp"
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace clrs {
+namespace graph {
+
+using std::vector;
+
+template <class W> class sssp_result {
+public:
+  static W infinity() { return std::numeric_limits<W>::max(); }
+
+  sssp_result() {}
+  sssp_result(int n, int source)
+      : source(source), dist(n, infinity()), parent(n, -1) {}
+  bool reached(int v) const { return dist[v] != infinity(); }
+
+  int source = -1;
+  vector<W> dist;
+  vector<int> parent; // -1 for the source and the unreachable vertices
+};
+
+// Dijkstra (CLRS 24.3), non-negative weights only.
+//
+// The priority queue is a template parameter, anything with the API of
+// tree::indexed_heap over the vertex ids works:
+//   Queue(n), empty(), contains(v), push(v, key), decrease_key(v, key),
+//   pop() -> the vertex of smallest key
+// The choices at hand:
+//   tree::indexed_binary_heap<W>  the CLRS one
+//   tree::indexed_heap<W, 4>      4-ary, shallower and more cache friendly
+//   tree::radix_heap<W>           integer weights only, monotone
+// Which one is fastest depends on the graph and the weights, see
+// dijkstra-bench.cpp.
+// obs sees the queue operations, the edges relaxed and the vertices as they
+// get a first distance (discover_vertex) and a final one (finish_vertex),
+// see observer.hpp.
+template <class Queue, class G, class Observer>
+sssp_result<typename G::weight_type> dijkstra(const G &g, int s,
+                                              Observer &obs) {
+  using W = typename G::weight_type;
+  const int n = num_vertices(g);
+  assert(s < n);
+  sssp_result<W> r(n, s);
+  Queue q(n);
+  r.dist[s] = 0;
+  q.push(s, 0);
+  obs.discover_vertex(s);
+  obs.heap_push(s);
+  while (!q.empty()) {
+    int u = q.pop(); // dist[u] is final from now on
+    obs.heap_pop(u);
+    obs.finish_vertex(u);
+    for (auto a : out_edges(g, u)) {
+      obs.examine_edge(u, a.to);
+      W d = r.dist[u] + a.weight;
+      if (d >= r.dist[a.to])
+        continue;
+      if (!r.reached(a.to))
+        obs.discover_vertex(a.to);
+      r.dist[a.to] = d;
+      r.parent[a.to] = u;
+      if (q.contains(a.to)) {
+        q.decrease_key(a.to, d);
+        obs.heap_decrease(a.to);
+      } else {
+        q.push(a.to, d);
+        obs.heap_push(a.to);
+      }
+    }
+  }
+  return r;
+}
+
+template <class Queue, class G>
+sssp_result<typename G::weight_type> dijkstra(const G &g, int s) {
+  null_observer obs;
+  return dijkstra<Queue>(g, s, obs);
+}
+
+template <class G, class Observer>
+sssp_result<typename G::weight_type> dijkstra(const G &g, int s,
+                                              Observer &obs) {
+  return dijkstra<tree::indexed_binary_heap<typename G::weight_type>>(g, s,
+                                                                      obs);
+}
+
+template <class G>
+sssp_result<typename G::weight_type> dijkstra(const G &g, int s) {
+  return dijkstra<tree::indexed_binary_heap<typename G::weight_type>>(g, s);
+}
+// Shortest paths in a DAG (CLRS 24.2): relax the edges out of each vertex,
+// the vertices taken in topological order.  When u is taken, all the edges
+// into u have been relaxed already, so dist[u] is final: one pass over the
+// edges, no heap, O(V+E), and negative weights are fine.
+// Throws cycle_error (toposort.hpp) if g isn't a DAG.
+template <class G>
+sssp_result<typename G::weight_type> dag_shortest_paths(const G &g, int s) {
+  using W = typename G::weight_type;
+  const int n = num_vertices(g);
+  assert(s < n);
+  sssp_result<W> r(n, s);
+  r.dist[s] = 0;
+  for (int u : topological_sort(g)) {
+    if (!r.reached(u))
+      continue;
+    for (auto a : out_edges(g, u)) {
+      W d = r.dist[u] + a.weight;
+      if (d < r.dist[a.to]) {
+        r.dist[a.to] = d;
+        r.parent[a.to] = u;
+      }
+    }
+  }
+  return r;
+}
+
+// delta-stepping (Meyer and Sanders), a parallel Dijkstra
+//
+// Dijkstra settles one vertex at a time, which leaves nothing to do in
+// parallel.  Delta-stepping groups the tentative distances into buckets of
+// width delta, bucket i holding [i*delta, (i+1)*delta), and settles a whole
+// bucket at a time:
+//  - the light edges (weight <= delta) out of the bucket can put vertices
+//    back into the same bucket, so they're relaxed in phases until the
+//    bucket stays empty,
+//  - the heavy edges can only reach later buckets, they're relaxed once at
+//    the end, from all the vertices the bucket ever held.
+// Within a phase the vertices are relaxed in parallel, dist[v] being
+// lowered with an atomic compare-and-swap.
+//
+// delta trades work for parallelism: a tiny delta is Dijkstra (one
+// distance per bucket, little to do in parallel), a huge delta is
+// Bellman-Ford (one bucket, many useless relaxations).  The average edge
+// weight is a reasonable start.
+//
+// The parents are computed once the distances are final, by a parallel
+// bfs on the tight edges (dist[u] + w == dist[v]) from s, so they always
+// form a shortest path tree, even with zero weights.
+template <class G>
+sssp_result<typename G::weight_type>
+delta_stepping(const G &g, int s, typename G::weight_type delta,
+               util::thread_pool &pool) {
+  using W = typename G::weight_type;
+  const int n = num_vertices(g), threads = pool.size();
+  assert(s < n && delta > 0);
+  const W inf = sssp_result<W>::infinity();
+  vector<std::atomic<W>> dist(n);
+  util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+    for (auto v = lo; v < hi; ++v)
+      dist[v].store(inf, std::memory_order_relaxed);
+  });
+  auto bucket_of = [&](W d) {
+    return static_cast<long long>(std::floor(static_cast<double>(d) / delta));
+  };
+  // the vertices whose distance was lowered, per thread
+  vector<vector<int>> lowered(threads);
+  auto relax = [&](int u, bool light, int tid) {
+    W du = dist[u].load(std::memory_order_relaxed);
+    for (auto a : out_edges(g, u)) {
+      if ((a.weight <= delta) != light)
+        continue;
+      W d = du + a.weight, old = dist[a.to].load(std::memory_order_relaxed);
+      while (d < old && !dist[a.to].compare_exchange_weak(
+                            old, d, std::memory_order_relaxed))
+        ;
+      if (d < old)
+        lowered[tid].push_back(a.to);
+    }
+  };
+  // runs body(v, tid) on every vertex of vs, inline when there are too few
+  // of them to be worth waking up the pool
+  auto for_all = [&](const vector<int> &vs, auto body) {
+    auto block = [&](size_t lo, size_t hi, int tid) {
+      for (auto i = lo; i < hi; ++i)
+        body(vs[i], tid);
+    };
+    if (vs.size() < 256)
+      block(0, vs.size(), 0);
+    else
+      util::parallel_for_dynamic(pool, 0, vs.size(), 64, block);
+  };
+
+  // bucket index -> vertices, a vertex can be in several buckets (or
+  // several times in one), only the entry matching its current distance
+  // counts
+  std::map<long long, vector<int>> buckets;
+  auto collect = [&] {
+    for (auto &l : lowered) {
+      for (int v : l)
+        buckets[bucket_of(dist[v].load(std::memory_order_relaxed))]
+            .push_back(v);
+      l.clear();
+    }
+  };
+  vector<int> stamp(n, -1), settled_stamp(n, -1), frontier, settled;
+  int phase = 0, round = 0;
+  dist[s].store(0);
+  buckets[0].push_back(s);
+  while (!buckets.empty()) {
+    long long i = buckets.begin()->first;
+    settled.clear();
+    ++round;
+    while (buckets.count(i)) {
+      // this phase: the vertices still in bucket i, each once
+      frontier.clear();
+      ++phase;
+      for (int v : buckets[i])
+        if (stamp[v] != phase &&
+            bucket_of(dist[v].load(std::memory_order_relaxed)) == i) {
+          stamp[v] = phase;
+          frontier.push_back(v);
+          if (settled_stamp[v] != round) {
+            settled_stamp[v] = round;
+            settled.push_back(v);
+          }
+        }
+      buckets.erase(i);
+      for_all(frontier, [&](int v, int tid) { relax(v, true, tid); });
+      collect();
+    }
+    for_all(settled, [&](int v, int tid) { relax(v, false, tid); });
+    collect();
+  }
+
+  sssp_result<W> r(n, s);
+  util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+    for (auto v = lo; v < hi; ++v)
+      r.dist[v] = dist[v].load(std::memory_order_relaxed);
+  });
+  // shortest path tree: bfs on the tight edges, claiming with a CAS
+  vector<std::atomic<int>> parent(n);
+  util::parallel_for(pool, 0, n, [&](size_t lo, size_t hi, int) {
+    for (auto v = lo; v < hi; ++v)
+      parent[v].store(-1, std::memory_order_relaxed);
+  });
+  parent[s].store(s);
+  frontier.assign(1, s);
+  while (!frontier.empty()) {
+    for_all(frontier, [&](int u, int tid) {
+      for (auto a : out_edges(g, u)) {
+        int expected = -1;
+        if (r.dist[u] + a.weight == r.dist[a.to] &&
+            parent[a.to].load(std::memory_order_relaxed) == -1 &&
+            parent[a.to].compare_exchange_strong(expected, u))
+          lowered[tid].push_back(a.to);
+      }
+    });
+    frontier.clear();
+    for (auto &l : lowered) {
+      frontier.insert(frontier.end(), l.begin(), l.end());
+      l.clear();
+    }
+  }
+  for (int v = 0; v < n; ++v)
+    r.parent[v] = parent[v].load(std::memory_order_relaxed);
+  r.parent[s] = -1;
+  return r;
+}
+
+template <class G>
+sssp_result<typename G::weight_type>
+delta_stepping(const G &g, int s, typename G::weight_type delta,
+               int threads) {
+  util::thread_pool pool(threads);
+  return delta_stepping(g, s, delta, pool);
+}
+}
+}
@@ -0,0 +1,105 @@
+// Data structure: Disjoint-set Forest (union-find)
+
+// Representation: Array, parent[i] is the parent of i in its tree, a root
+// is its own parent.
+
+// Description: Keeps a partition of the integers 0..n-1 into disjoint sets
+// (CLRS 21.3).  Each set is a tree whose root is the representative.
+// Two heuristics keep the trees flat:
+//  - union by size: the root of the smaller tree goes under the root of the
+//    bigger one, so a tree of height h has at least 2^h elements,
+//  - path halving: while walking up to the root, every other node is linked
+//    to its grandparent.  Same effect as the path compression of CLRS
+//    (the nodes walked end up much closer to the root) but in a single pass
+//    and without recursion.
+// With both, a sequence of m operations costs O(m alpha(n)), alpha being
+// the inverse Ackermann function (<= 4 for any n we'll ever see).
+// Everything lives in two flat int arrays, no node object, no pointer.
+
+// APIs
+// find : the representative of the set of i...........O(alpha(n)) amortized
+// unite : merge the sets of i and j, false if already the same set.......same
+// same : whether i and j are in the same set............................same
+// root_of : find without any write (safe with concurrent readers).....O(lgn)
+
+// The operations are counted, the counters tell how much work the
+// union-find does in an algorithm (e.g. Kruskal).  root_of, being const,
+// counts the links it walks into a counter of the caller.
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace clrs {
+namespace tree {
+
+class disjoint_set {
+public:
+  explicit disjoint_set(int n = 0) : _parent(n), _size(n, 1), _sets(n) {
+    for (int i = 0; i < n; ++i)
+      _parent[i] = i;
+  }
+
+  int size() const { return static_cast<int>(_parent.size()); }
+  // number of disjoint sets
+  int sets() const { return _sets; }
+  int set_size(int i) { return _size[find(i)]; }
+
+  int find(int i) {
+    ++finds;
+    while (_parent[i] != i) {
+      ++steps;
+      _parent[i] = _parent[_parent[i]]; // halving
+      i = _parent[i];
+    }
+    return i;
+  }
+
+  // no path halving, so nothing is written and several threads can call it
+  // at the same time as long as nobody unites
+  int root_of(int i) const {
+    while (_parent[i] != i)
+      i = _parent[i];
+    return i;
+  }
+  // the same, adding the links walked up to steps
+  int root_of(int i, std::size_t &steps) const {
+    while (_parent[i] != i) {
+      ++steps;
+      i = _parent[i];
+    }
+    return i;
+  }
+
+  bool same(int i, int j) { return find(i) == find(j); }
+
+  bool unite(int i, int j) {
+    ++unions;
+    i = find(i);
+    j = find(j);
+    if (i == j)
+      return false;
+    if (_size[i] < _size[j])
+      std::swap(i, j);
+    _parent[j] = i;
+    _size[i] += _size[j];
+    --_sets;
+    ++links;
+    return true;
+  }
+
+  // operation counters
+  std::size_t finds = 0;  // calls to find (unite calls it twice)
+  std::size_t steps = 0;  // parent links walked up by find
+  std::size_t unions = 0; // calls to unite
+  std::size_t links = 0;  // unite calls that merged two sets
+
+private:
+  std::vector<int> _parent;
+  std::vector<int> _size; // only meaningful for the roots
+  int _sets;
+};
+}
+}
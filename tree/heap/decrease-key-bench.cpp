@@ -0,0 +1,146 @@
+// priority queues on decrease-key heavy workloads
+//
+// g++ decrease-key-bench.cpp -std=c++14 -O2
+// ./a.out [vertices=2^14] [out-degree=256]
+//
+// The workload is the sequence of queue operations of Dijkstra on a dense
+// random graph (the trace): push, decrease-key and pop-min of vertices.
+// The trace is recorded once, then replayed on each queue:
+//  - the indexed binary and 4-ary heaps of heap.hpp,
+//  - the Fibonacci and pairing heaps, with one node pool reset between the
+//    runs.
+// The times are in ns per operation.
+
+#include "../../graph/basics/csr.hpp"
+#include "../../graph/basics/generators.hpp"
+#include "../../util/bench.hpp"
+#include "fibonacci-heap.hpp"
+#include "heap.hpp"
+#include "pairing-heap.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+using namespace std;
+using namespace clrs::graph;
+using namespace clrs::tree;
+using namespace clrs::util;
+
+using W = long long;
+
+struct op {
+  enum kind { push, decrease, pop } what;
+  int item;
+  W key;
+};
+
+// Dijkstra from 0, recording what it asks of the queue
+vector<op> dijkstra_trace(const weighted_csr_graph<W> &g) {
+  const int n = num_vertices(g);
+  const W inf = numeric_limits<W>::max();
+  vector<W> dist(n, inf);
+  vector<op> trace;
+  indexed_binary_heap<W> q(n);
+  dist[0] = 0;
+  q.push(0, 0);
+  trace.push_back(op{op::push, 0, 0});
+  while (!q.empty()) {
+    int u = q.pop();
+    trace.push_back(op{op::pop, u, dist[u]});
+    for (auto a : out_edges(g, u)) {
+      W d = dist[u] + a.weight;
+      if (d >= dist[a.to])
+        continue;
+      bool queued = dist[a.to] != inf;
+      dist[a.to] = d;
+      if (queued) {
+        q.decrease_key(a.to, d);
+        trace.push_back(op{op::decrease, a.to, d});
+      } else {
+        q.push(a.to, d);
+        trace.push_back(op{op::push, a.to, d});
+      }
+    }
+  }
+  return trace;
+}
+
+// the popped keys are summed up to check that every queue pops the same
+template <class Queue> W replay_indexed(const vector<op> &trace, int n) {
+  Queue q(n);
+  W sum = 0;
+  for (auto &o : trace) {
+    if (o.what == op::push)
+      q.push(o.item, o.key);
+    else if (o.what == op::decrease)
+      q.decrease_key(o.item, o.key);
+    else
+      sum += q.key(q.pop());
+  }
+  return sum;
+}
+
+template <class Heap>
+W replay_handles(const vector<op> &trace, int n,
+                 typename Heap::pool_type &pool) {
+  pool.reset();
+  Heap q(pool);
+  vector<typename Heap::handle> handle(n);
+  W sum = 0;
+  for (auto &o : trace) {
+    if (o.what == op::push)
+      handle[o.item] = q.push(o.key, o.item);
+    else if (o.what == op::decrease)
+      q.decrease_key(handle[o.item], o.key);
+    else {
+      sum += q.min_key();
+      q.extract_min();
+    }
+  }
+  return sum;
+}
+
+int main(int argc, char **argv) {
+  int n = argc > 1 ? atoi(argv[1]) : 1 << 14;
+  long long degree = argc > 2 ? atoll(argv[2]) : 256;
+  auto edges =
+      with_random_weights<W>(erdos_renyi_edges(n, degree * n, 1), 1, 1000, 2);
+  weighted_csr_graph<W> g(n, edges);
+  auto trace = dijkstra_trace(g);
+  size_t pushes = 0, decreases = 0;
+  for (auto &o : trace) {
+    pushes += o.what == op::push;
+    decreases += o.what == op::decrease;
+  }
+  printf("%d vertices, %zu edges: %zu operations, %zu pushes, %zu "
+         "decrease-keys\n",
+         n, edges.size(), trace.size(), pushes, decreases);
+  printf("%-24s %10s\n", "queue", "ns/op");
+
+  W expected = 0, sum = 0;
+  auto report = [&](const char *name, double t) {
+    assert(sum == expected);
+    printf("%-24s %10.2f\n", name, t * 1e9 / trace.size());
+  };
+  double t = best_time(5, [&] {
+    expected = replay_indexed<indexed_binary_heap<W>>(trace, n);
+  });
+  sum = expected;
+  report("indexed binary heap", t);
+  t = best_time(5, [&] {
+    sum = replay_indexed<indexed_heap<W, 4>>(trace, n);
+  });
+  report("indexed 4-ary heap", t);
+  fibonacci_heap<W>::pool_type fpool;
+  t = best_time(5, [&] {
+    sum = replay_handles<fibonacci_heap<W>>(trace, n, fpool);
+  });
+  report("fibonacci heap", t);
+  pairing_heap<W>::pool_type ppool;
+  t = best_time(5, [&] {
+    sum = replay_handles<pairing_heap<W>>(trace, n, ppool);
+  });
+  report("pairing heap", t);
+}
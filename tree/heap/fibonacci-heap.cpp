@@ -0,0 +1,117 @@
+// Fibonacci heap and pairing heap, see fibonacci-heap.hpp and
+// pairing-heap.hpp
+//
+// g++ fibonacci-heap.cpp -std=c++14
+
+#include "fibonacci-heap.hpp"
+#include "pairing-heap.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace clrs::tree;
+
+// random pushes, decrease-keys and extract-mins checked against a
+// std::set of (key, value), the heaps melded two by two from time to time
+template <class Heap> void check(typename Heap::pool_type &pool) {
+  mt19937 rng(7);
+  const int n = 20000;
+  Heap h(pool), other(pool);
+  vector<typename Heap::handle> handle(n, nullptr);
+  set<pair<int, int>> expected;
+  int next = 0;
+  for (int step = 0; step < 200000; ++step) {
+    int op = rng() % 10;
+    if (op < 4 && next < n) {
+      int k = rng() % 1000000;
+      // half of them go to the other heap, melded later
+      handle[next] = (rng() & 1 ? h : other).push(k, next);
+      expected.emplace(k, next++);
+    } else if (op < 8 && !expected.empty()) {
+      int v = rng() % next;
+      if (!handle[v])
+        continue;
+      int k = Heap::key(handle[v]);
+      int lower = k - static_cast<int>(rng() % (k + 1));
+      expected.erase(make_pair(k, v));
+      expected.emplace(lower, v);
+      // both heaps own some of the handles, the decrease has to go to the
+      // right one: meld first
+      h.meld(other);
+      h.decrease_key(handle[v], lower);
+    } else if (op < 9) {
+      h.meld(other);
+    } else if (!expected.empty()) {
+      h.meld(other);
+      assert(h.min_key() == expected.begin()->first);
+      int v = h.extract_min();
+      auto it = expected.begin();
+      // equal keys may come out in any order
+      auto found = expected.end();
+      for (auto j = it; j != expected.end() && j->first == it->first; ++j)
+        if (j->second == v)
+          found = j;
+      assert(found != expected.end());
+      expected.erase(found);
+      handle[v] = nullptr;
+    }
+  }
+  h.meld(other);
+  assert(h.size() == expected.size());
+  int last = -1;
+  while (!h.empty()) {
+    int k = h.min_key();
+    assert(k >= last);
+    last = k;
+    h.extract_min();
+  }
+  assert(pool.allocated() == 0);
+}
+
+int main() {
+
+  // the keys of CLRS P.512 Figure 19.3, the values are the keys as well
+  fibonacci_heap<int> f;
+  for (int k : {23, 7, 21, 3, 18, 52, 38, 39, 41, 17, 30, 24, 26, 46, 35})
+    f.push(k, k);
+  assert(f.size() == 15 && f.min_key() == 3);
+  // the first extract_min consolidates the 15 one node trees
+  assert(f.extract_min() == 3 && f.min_key() == 7);
+  fibonacci_heap<int>::handle h46 = nullptr;
+  f.clear();
+  for (int k : {46, 35, 26, 24, 30, 17})
+    if (k == 46)
+      h46 = f.push(k, k);
+    else
+      f.push(k, k);
+  f.extract_min(); // 17, the others now sit in trees
+  f.decrease_key(h46, 15);
+  assert(f.min_key() == 15 && f.extract_min() == 46);
+  cout << "fibonacci heap: ";
+  while (!f.empty())
+    cout << f.extract_min() << " ";
+  cout << "\n";
+
+  pairing_heap<int> p;
+  for (int k : {5, 1, 4, 2, 3})
+    p.push(k, k);
+  cout << "pairing heap: ";
+  while (!p.empty())
+    cout << p.extract_min() << " ";
+  cout << "\n";
+
+  fibonacci_heap<int>::pool_type fpool;
+  check<fibonacci_heap<int>>(fpool);
+  pairing_heap<int>::pool_type ppool;
+  check<pairing_heap<int>>(ppool);
+  // the same pools again, after a reset the memory is reused
+  auto capacity = fpool.capacity();
+  fpool.reset();
+  check<fibonacci_heap<int>>(fpool);
+  assert(fpool.capacity() == capacity);
+  cout << "random operations: ok\n";
+}
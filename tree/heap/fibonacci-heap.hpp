@@ -0,0 +1,259 @@
+// Data structure: Fibonacci Heap (CLRS 19)
+
+// Representation: Forest of heap ordered trees, linked nodes.  The roots
+// are in a circular doubly linked list (the root list), and so are the
+// children of every node.  min points at the root of smallest key.
+
+// Description: A mergeable heap that's as lazy as it can be:
+//  - push adds a one node tree to the root list, meld splices two root
+//    lists, neither ever compares more than the two minimums.
+//  - extract_min is where the work is done: the children of the minimum go
+//    to the root list, then the trees of the same degree (number of
+//    children) are linked two by two, the larger root under the smaller,
+//    until all the roots have different degrees (consolidate).
+//  - decrease_key cuts the node from its parent into the root list when the
+//    key breaks the heap order.  A node that loses a second child is cut as
+//    well (cascading cut), a mark remembers the first loss.  This keeps the
+//    size of a tree exponential in the degree of its root, and so the
+//    degrees O(lgN).
+// The amortized costs below come from the potential (roots + 2 * marked
+// nodes), see CLRS 19.2-19.4.
+//
+// The items pushed are a key and a value (say the vertex), push returns a
+// handle to the node, which stays valid until its item is extracted.
+// The nodes come from a node_pool (node-pool.hpp), shared by heaps that
+// are melded together: clear just forgets the nodes, the pool's reset
+// frees them all at once.
+
+// APIs
+// push : insert (key, value), returns its handle...........................O(1)
+// meld : move all the items of another heap (same pool) into this one......O(1)
+// decrease_key : lower the key of an item by its handle........O(1) amortized
+// extract_min : remove the item of smallest key, return its value
+//               ...........................................O(lgN) amortized
+// top/min_key/min_value/key/value/empty/size...............................O(1)
+
+#pragma once
+
+#include "node-pool.hpp"
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace clrs {
+namespace tree {
+
+template <class Key, class Value = int, class Comparator = std::less<Key>>
+class fibonacci_heap {
+  struct node {
+    Key key;
+    Value value;
+    node *parent, *child, *left, *right;
+    int degree;
+    bool mark;
+  };
+
+public:
+  using key_type = Key;
+  using value_type = Value;
+  using handle = node *;
+  using pool_type = node_pool<node>;
+
+  // with a pool of its own
+  fibonacci_heap() : _own(new pool_type), _pool(_own.get()) {}
+  explicit fibonacci_heap(pool_type &pool) : _pool(&pool) {}
+  fibonacci_heap(const fibonacci_heap &) = delete;
+  fibonacci_heap &operator=(const fibonacci_heap &) = delete;
+
+  bool empty() const { return _size == 0; }
+  std::size_t size() const { return _size; }
+  handle top() const { return _min; }
+  const Key &min_key() const { return _min->key; }
+  const Value &min_value() const { return _min->value; }
+  static const Key &key(handle h) { return h->key; }
+  static const Value &value(handle h) { return h->value; }
+
+  handle push(const Key &k, const Value &v) {
+    node *x = _pool->allocate();
+    x->key = k;
+    x->value = v;
+    x->parent = x->child = nullptr;
+    x->degree = 0;
+    x->mark = false;
+    add_root(x);
+    ++_size;
+    return x;
+  }
+
+  void meld(fibonacci_heap &other) {
+    assert(_pool == other._pool);
+    if (!other._min)
+      return;
+    if (!_min) {
+      _min = other._min;
+    } else {
+      splice(_min, other._min);
+      if (_comp(other._min->key, _min->key))
+        _min = other._min;
+    }
+    _size += other._size;
+    other._min = nullptr;
+    other._size = 0;
+  }
+
+  void decrease_key(handle x, const Key &k) {
+    assert(!_comp(x->key, k));
+    x->key = k;
+    node *y = x->parent;
+    if (y && _comp(x->key, y->key)) {
+      cut(x, y);
+      cascading_cut(y);
+    }
+    if (_comp(x->key, _min->key))
+      _min = x;
+  }
+
+  Value extract_min() {
+    assert(!empty());
+    node *z = _min;
+    // the children of z become roots
+    if (z->child) {
+      node *c = z->child;
+      do {
+        c->parent = nullptr;
+        c = c->right;
+      } while (c != z->child);
+      splice(z, z->child);
+    }
+    // then z leaves the root list
+    if (z->right == z) {
+      _min = nullptr;
+    } else {
+      _min = z->right;
+      unlink(z);
+      consolidate();
+    }
+    --_size;
+    Value v = z->value;
+    _pool->release(z);
+    return v;
+  }
+
+  // forgets all the items, their nodes come back with the pool's reset
+  // (right away if the heap has a pool of its own)
+  void clear() {
+    _min = nullptr;
+    _size = 0;
+    if (_own)
+      _own->reset();
+  }
+
+private:
+  // x alone becomes a root
+  void add_root(node *x) {
+    x->left = x->right = x;
+    if (!_min) {
+      _min = x;
+      return;
+    }
+    splice(_min, x);
+    if (_comp(x->key, _min->key))
+      _min = x;
+  }
+
+  // joins the circular lists of a and b
+  static void splice(node *a, node *b) {
+    node *a_right = a->right, *b_left = b->left;
+    a->right = b;
+    b->left = a;
+    b_left->right = a_right;
+    a_right->left = b_left;
+  }
+
+  static void unlink(node *x) {
+    x->left->right = x->right;
+    x->right->left = x->left;
+    x->left = x->right = x;
+  }
+
+  // links the roots of the same degree until there are no two of them,
+  // CLRS P.516
+  void consolidate() {
+    // the degrees are at most log_phi(N) < 1.45 lgN
+    std::size_t bound = 2;
+    for (std::size_t m = _size; m; m >>= 1)
+      bound += 2;
+    _by_degree.assign(bound, nullptr);
+    _roots.clear();
+    node *w = _min;
+    do {
+      _roots.push_back(w);
+      w = w->right;
+    } while (w != _min);
+    for (node *x : _roots) {
+      int d = x->degree;
+      while (node *y = _by_degree[d]) {
+        if (_comp(y->key, x->key))
+          std::swap(x, y);
+        link(y, x);
+        _by_degree[d++] = nullptr;
+      }
+      _by_degree[d] = x;
+    }
+    // the root list is rebuilt from the table
+    _min = nullptr;
+    for (node *x : _by_degree)
+      if (x)
+        add_root(x);
+  }
+
+  // root y becomes a child of root x, y's root list links are left as they
+  // are, consolidate rebuilds the root list
+  static void link(node *y, node *x) {
+    y->parent = x;
+    y->mark = false;
+    y->left = y->right = y;
+    if (x->child)
+      splice(x->child, y);
+    else
+      x->child = y;
+    ++x->degree;
+  }
+
+  // x leaves its parent y for the root list
+  void cut(node *x, node *y) {
+    if (x->right == x)
+      y->child = nullptr;
+    else if (y->child == x)
+      y->child = x->right;
+    unlink(x);
+    --y->degree;
+    x->parent = nullptr;
+    x->mark = false;
+    add_root(x);
+  }
+
+  // going up from y, cut every node that already lost a child
+  void cascading_cut(node *y) {
+    while (node *z = y->parent) {
+      if (!y->mark) {
+        y->mark = true;
+        return;
+      }
+      cut(y, z);
+      y = z;
+    }
+  }
+
+  std::unique_ptr<pool_type> _own;
+  pool_type *_pool;
+  node *_min = nullptr;
+  std::size_t _size = 0;
+  Comparator _comp;
+  std::vector<node *> _by_degree, _roots; // consolidate's scratch
+};
+}
+}
@@ -0,0 +1,123 @@
+// d-ary heap benchmark against std::priority_queue
+//
+// g++ heap-bench.cpp -std=c++14 -O2
+// ./a.out [max size=2^22]
+//
+// For each element type and size N, two workloads on min heaps:
+//  push/pop: N pushes one by one then N pops
+//  make/pop: the heap built from N elements at once (make_heap, push_range
+//            into an empty heap) then N pops
+// The elements are random, the times in ns per element.
+
+#include "../../util/bench.hpp"
+#include "heap.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace clrs::tree;
+using namespace clrs::util;
+
+// a heavier element: a key and a payload that has to move along
+struct record {
+  long long key;
+  char payload[24];
+  bool operator<(const record &o) const { return key < o.key; }
+  bool operator>(const record &o) const { return o < *this; }
+};
+
+template <class T> T make_element(mt19937_64 &rng);
+template <> int make_element<int>(mt19937_64 &rng) {
+  return static_cast<int>(rng() >> 33);
+}
+template <> double make_element<double>(mt19937_64 &rng) {
+  return uniform_real_distribution<double>(0, 1)(rng);
+}
+template <> record make_element<record>(mt19937_64 &rng) {
+  return record{static_cast<long long>(rng() >> 1), {}};
+}
+
+void report(const char *type, size_t n, const char *heap, double push_pop,
+            double make_pop) {
+  printf("%-8s %10zu %-22s %10.2f %10.2f\n", type, n, heap, push_pop * 1e9 / n,
+         make_pop * 1e9 / n);
+}
+
+// a min heap with the d_ary_heap API over std::priority_queue
+template <class T> class std_heap {
+public:
+  std_heap() {}
+  template <class It> std_heap(It first, It last) : _q(first, last) {}
+  void push(const T &t) { _q.push(t); }
+  T pop() {
+    T t = _q.top();
+    _q.pop();
+    return t;
+  }
+  bool empty() const { return _q.empty(); }
+
+private:
+  priority_queue<T, vector<T>, greater<T>> _q;
+};
+
+template <class Heap, class T>
+void run(const char *type, const char *name, const vector<T> &input,
+         const vector<T> &sorted) {
+  size_t n = input.size();
+  int repeat = n < (1 << 16) ? 20 : 3;
+  vector<T> out(n);
+  double push_pop = best_time(repeat, [&] {
+    Heap h;
+    for (auto &x : input)
+      h.push(x);
+    for (auto &x : out)
+      x = h.pop();
+  });
+  assert(!(out.front() < sorted.front()) && !(sorted.back() < out.back()));
+  double make_pop = best_time(repeat, [&] {
+    Heap h(input.begin(), input.end());
+    for (auto &x : out)
+      x = h.pop();
+  });
+  for (size_t i = 0; i < n; ++i)
+    assert(!(out[i] < sorted[i]) && !(sorted[i] < out[i]));
+  report(type, n, name, push_pop, make_pop);
+}
+
+template <class T> void run_type(const char *type, size_t max_n) {
+  mt19937_64 rng(1);
+  for (size_t n = 1 << 10; n <= max_n; n <<= 4) {
+    vector<T> input(n);
+    for (auto &x : input)
+      x = make_element<T>(rng);
+    auto sorted = input;
+    sort(sorted.begin(), sorted.end());
+    run<std_heap<T>>(type, "std::priority_queue", input, sorted);
+    run<d_ary_heap<T, 2>>(type, "binary_heap", input, sorted);
+    run<d_ary_heap<T, 4>>(type, "d_ary_heap<4>", input, sorted);
+    run<d_ary_heap<T, 8>>(type, "d_ary_heap<8>", input, sorted);
+
+    // push_range into a heap holding half the elements already
+    d_ary_heap<T, 4> h(input.begin(), input.begin() + n / 2);
+    h.push_range(input.begin() + n / 2, input.end());
+    for (auto &x : sorted) {
+      T y = h.pop();
+      assert(!(x < y) && !(y < x));
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  size_t max_n = argc > 1 ? atoll(argv[1]) : 1 << 22;
+  printf("%-8s %10s %-22s %10s %10s\n", "type", "N", "heap", "push/pop",
+         "make/pop");
+  run_type<int>("int", max_n);
+  run_type<double>("double", max_n);
+  run_type<record>("record", max_n);
+}
@@ -1,4 +1,4 @@
-// Data structure: Binary Heap
+// Data structure: Binary Heap (d-ary)
 
 // Representation: Array
 
@@ -6,6 +6,13 @@
 // from the left) binary tree that maintains the invariant that for min heap
 // the parent node's value is always no bigger than those of its children's and
 // for max heap no smaller.
+// The tree is stored level by level in one contiguous array A[0..n): with
+// 0-based indices the children of i are 2i+1 and 2i+2 and its parent is
+// (i-1)/2.  Nothing forces a node to have two children: with d children the
+// children of i are d*i+1..d*i+d and its parent (i-1)/d.  The heap gets
+// shallower (log_d N levels), and the d children compared at each level of
+// a sift-down sit next to each other, for d = 4 or 8 and small elements in
+// one or two cache lines.
 
 // Symbol: A (convention in this notes)
 
@@ -21,11 +28,14 @@
 //          is that of the root.
 
 // APIs
-// The API is named such that the binary_heap class template can be used
-// directly as a min(max) heap(priority queue).
-// extract_root: extract_min/max for min/max heap ..........................O(1)
-// make_heap : organize an unordered array into a heap in O(1) time.........O(1)
-// heapify : maintains the heap invariant, max_heapify for max heap.......O(lgN)
+// The API is named such that the d_ary_heap class template can be used
+// directly as a min(max) heap(priority queue), like std::priority_queue.
+// top : min/max for min/max heap...........................................O(1)
+// pop : extract_min/max for min/max heap...............................O(dlgN)
+// push : insert an element...............................................O(lgN)
+// push_range : insert k elements...........................O(min(klgN, N + k))
+// make_heap : organize an unordered array into a heap.....................O(N)
+// heapify : maintains the heap invariant, max_heapify for max heap......O(dlgN)
 
 // Applications:
 //  - heapsort
@@ -35,42 +45,105 @@
 // heap.  One can also use the ready-made std::priority_queue.
 // This is just an exercise for understanding the data structure
 
+#pragma once
+
 #include <algorithm>
-#include <deque>
+#include <cassert>
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
 
 namespace clrs {
 namespace tree {
-using std::deque;
-// TODO: replace all int i with proper iterators
-template <class T, class Comparator = std::less<T>> class binary_heap {
+
+template <class T, int Arity = 2, class Comparator = std::less<T>>
+class d_ary_heap {
   // if it's the default less comparator, then it's a min heap
   // std::greater for max heap
 public:
+  using value_type = T;
+  using size_type = std::size_t;
+  static_assert(Arity >= 2, "a heap node has at least two children");
+
+  d_ary_heap() {}
+  explicit d_ary_heap(const Comparator &comp) : _comp(comp) {}
+  // the elements of [first, last) organized with make_heap, O(N)
+  template <class It>
+  d_ary_heap(It first, It last, const Comparator &comp = Comparator())
+      : _v(first, last), _comp(comp) {
+    make_heap();
+  }
+
+  bool empty() const { return _v.empty(); }
+  size_type size() const { return _v.size(); }
+  void reserve(size_type n) { _v.reserve(n); }
+  void clear() { _v.clear(); }
+  const T &top() const {
+    assert(!empty());
+    return _v.front();
+  }
+
+  // Put the new element at the end (bottom of the tree) and flow it up
+  // This procedure is also bounded by the heap height
+  void push(const T &t) {
+    _v.push_back(t);
+    sift_up(_v.size() - 1);
+  }
+  void push(T &&t) {
+    _v.push_back(std::move(t));
+    sift_up(_v.size() - 1);
+  }
+  template <class... Args> void emplace(Args &&... args) {
+    _v.emplace_back(std::forward<Args>(args)...);
+    sift_up(_v.size() - 1);
+  }
+
+  // k elements at once: k sift-ups cost O(klgN), rebuilding the whole heap
+  // O(N + k), whichever is cheaper
+  template <class It> void push_range(It first, It last) {
+    size_type n = _v.size();
+    _v.insert(_v.end(), first, last);
+    size_type k = _v.size() - n, height = 0;
+    for (size_type m = _v.size(); m > 1; m /= Arity)
+      ++height;
+    if (k * height > _v.size()) {
+      make_heap();
+      return;
+    }
+    for (size_type i = n; i < _v.size(); ++i)
+      sift_up(i);
+  }
+
+  // Move the root out, the last element takes its place and flows down.
+  // The nice thing about the pop procedure is that it doesn't know or care
+  // about whether it's a min heap or a max heap, everything is hidden in the
+  // heapify procedure.
+  T pop() {
+    assert(!empty());
+    T root = std::move(_v.front());
+    if (_v.size() > 1) {
+      T last = std::move(_v.back());
+      _v.pop_back();
+      sift_down(0, std::move(last));
+    } else {
+      _v.pop_back();
+    }
+    return root;
+  }
+
   // This procedure is called to bring the invariant back.  It's assumed that
   // when it's called on node i, the invariants of the sub trees rooted at
-  // left_child(i) and right_child(i) are not broken but the node i may have
-  // to be "float down" the tree.
+  // the children of i are not broken but the node i may have to be "float
+  // down" the tree.
   // Analysis: This procedure is bounded by the height of the heap thus
-  // finishes in O(lgN) time.
-  void heapify(int i) {
-    int lchild = left_child(i);
-    int rchild = right_child(i);
-    // When the invariant is broken, we need to make a 3-way comparison among
-    // left_child(i), right_child(i) and i itself.
-    int smallest = i;
-    if (lchild < _v.length() && Comparator()(_v[lchild], _v[i])) {
-      smallest = lchild;
-    }
-    if (rchild < _v.length() && Comparator()(_v[rchild], _v[smallest])) {
-      smallest = rchild;
-    }
-    if (smallest != i) {
-      this->swap(i, smallest);
-      // keep flowing it down
-      heapify(smallest); // TODO: a non recursive solution?
-    }
-    // otherwise we are already a min or max heap
+  // finishes in O(dlgN) time (d comparisons per level).
+  void heapify(size_type i) {
+    if (i >= _v.size())
+      return;
+    T t = std::move(_v[i]);
+    sift_down(i, std::move(t));
   }
 
   // This procedure organizes an unordered array into a heap.
@@ -78,54 +151,173 @@ public:
   // has fewer nodes when we are approaching to the root).
   // See detailed analysis on P.157-159 of CLRS
   void make_heap() {
-    // We just need to take care of the first half of the array because
-    // the second half is all leafs.  Each leaf itself is already a 1-element
+    // We just need to take care of the nodes that have children because
+    // all the others are leafs.  Each leaf itself is already a 1-element
     // heap so the invariant holds trivially.  While taking care of the leafs'
-    // parents (all in the first half), any necessary "float down" will happen.
-    for (int i = _v.length() / 2; i >= 0; --i) {
-      heapify(i); // TODO: use a non recursive solution
-    }
+    // parents, any necessary "float down" will happen.
+    if (_v.size() < 2)
+      return;
+    for (size_type i = parent(_v.size() - 1) + 1; i-- > 0;)
+      heapify(i);
   }
 
-  // Put the new element at the end (bottom of the tree) and flow it up
-  // This procedure is also bounded by the heap height
-  void insert(T &&t) {
-    _v.push_back(t);
-    for (int i = _v.length() - 1; i > 0; i = parent(i)) {
-      auto p = parent(i);
-      // if the element is smaller than its parent, we swap it with its parent
-      if(Comparator()(_v.back(), _v[p]){
-        iter_swap(_v.length() - 1, p);
-      }
+protected:
+  static size_type parent(size_type i) { return (i - 1) / Arity; }
+  static size_type first_child(size_type i) { return Arity * i + 1; }
+
+private:
+  // Both sifts move a "hole" instead of swapping: the element is held aside,
+  // the elements in its way are moved into the hole one level at a time and
+  // the element is written once where the hole stops.
+  void sift_up(size_type i) {
+    T t = std::move(_v[i]);
+    while (i > 0) {
+      size_type p = parent(i);
+      // if the element is smaller than its parent, the parent comes down
+      if (!_comp(t, _v[p]))
+        break;
+      _v[i] = std::move(_v[p]);
+      i = p;
     }
+    _v[i] = std::move(t);
   }
 
-  T extract_root() {
-    if (_v.empty()) {
-      throw; // TODO: proper exception class
+  // the hole is at i, t is the element to put in the subtree rooted at i
+  void sift_down(size_type i, T &&t) {
+    const size_type n = _v.size();
+    for (;;) {
+      size_type first = first_child(i);
+      if (first >= n)
+        break;
+      // When the invariant is broken, we need to make a (d+1)-way comparison
+      // among the children of i and the element itself.
+      size_type last = std::min(first + Arity, n), best = first;
+      for (size_type c = first + 1; c < last; ++c)
+        if (_comp(_v[c], _v[best]))
+          best = c;
+      if (!_comp(_v[best], t))
+        break;
+      // keep flowing it down
+      _v[i] = std::move(_v[best]);
+      i = best;
     }
-    T = _v[0];
-    _v[0] = _v[_v.length() - 1];
-    heapify(0); // The nice thing about the extract_root procedure is that
-                // it doesn't know or care about whether it's a min heap or
-                // a max heap, everything is hidden in the heapify procedure.
-    return std::move(T);
+    _v[i] = std::move(t);
   }
 
-protected:
-  inline int parent(int i) {
-    // TODO: maybe we should throw if the user asks us the parent of the root
-    return (i - 1) / 2;
-  }
+  std::vector<T> _v; // for storage, contiguous
+  Comparator _comp;
+};
+
+template <class T, class Comparator = std::less<T>>
+using binary_heap = d_ary_heap<T, 2, Comparator>;
+
+// Data structure: Indexed d-ary Heap
 
-  inline int left_child(int i) { return 2 * i - 1; }
+// Representation: Array of items + position of each item in the array
 
-  inline int right_child(int i) { return 2 * i; }
+// Description: The items are the integers 0..n-1 (typically vertex ids),
+// each with a key.  The heap invariant is on the keys, with d children per
+// node instead of 2: the children of i are d*i+1..d*i+d and its parent is
+// (i-1)/d.  A wider heap is shallower (log_d N levels), so sift-up (push,
+// decrease_key) gets cheaper while sift-down (pop) compares d children per
+// level.  With d = 4 the children of a node sit together in one cache line.
+// Because we also know where each item is in the array (pos), the key of
+// an item already in the heap can be decreased in place: this is the
+// DECREASE-KEY of CLRS 6.5 that Dijkstra and Prim need.
 
-  inline void swap(int i, int j) { std::iter_swap(_v.at(i), _v.at(j)); }
+// APIs
+// push : insert item i with key k.......................................O(lgN)
+// decrease_key : lower the key of item i already in the heap............O(lgN)
+// pop : remove and return the item of smallest key.....................O(dlgN)
+// contains/key/top/empty/size..........................................O(1)
+
+template <class Key, int Arity = 2, class Comparator = std::less<Key>>
+class indexed_heap {
+public:
+  using key_type = Key;
+  static_assert(Arity >= 2, "a heap node has at least two children");
+
+  // items are 0..n-1
+  explicit indexed_heap(int n = 0) : _pos(n, -1), _key(n) {}
+
+  bool empty() const { return _heap.empty(); }
+  int size() const { return static_cast<int>(_heap.size()); }
+  bool contains(int i) const { return _pos[i] >= 0; }
+  const Key &key(int i) const { return _key[i]; }
+  int top() const { return _heap.front(); }
+
+  void push(int i, const Key &k) {
+    assert(!contains(i));
+    _key[i] = k;
+    _pos[i] = size();
+    _heap.push_back(i);
+    sift_up(_pos[i]);
+  }
+
+  void decrease_key(int i, const Key &k) {
+    assert(contains(i) && !Comparator()(_key[i], k));
+    _key[i] = k;
+    sift_up(_pos[i]);
+  }
+
+  int pop() {
+    assert(!empty());
+    int root = _heap.front();
+    _pos[root] = -1;
+    int last = _heap.back();
+    _heap.pop_back();
+    if (!_heap.empty()) {
+      _heap[0] = last;
+      _pos[last] = 0;
+      sift_down(0);
+    }
+    return root;
+  }
 
 private:
-  deque<T> _v; // for storage
+  // the item at i moves up while its key is smaller than its parent's,
+  // the parents are shifted down and the item written once at the end
+  void sift_up(int i) {
+    int item = _heap[i];
+    while (i > 0) {
+      int p = (i - 1) / Arity;
+      if (!Comparator()(_key[item], _key[_heap[p]]))
+        break;
+      place(i, _heap[p]);
+      i = p;
+    }
+    place(i, item);
+  }
+
+  void sift_down(int i) {
+    int item = _heap[i], n = size();
+    for (;;) {
+      int first = Arity * i + 1;
+      if (first >= n)
+        break;
+      int last = std::min(first + Arity, n), best = first;
+      for (int c = first + 1; c < last; ++c)
+        if (Comparator()(_key[_heap[c]], _key[_heap[best]]))
+          best = c;
+      if (!Comparator()(_key[_heap[best]], _key[item]))
+        break;
+      place(i, _heap[best]);
+      i = best;
+    }
+    place(i, item);
+  }
+
+  void place(int i, int item) {
+    _heap[i] = item;
+    _pos[item] = i;
+  }
+
+  std::vector<int> _heap; // the items, heap ordered on their keys
+  std::vector<int> _pos;  // position of each item in _heap, -1 if absent
+  std::vector<Key> _key;
 };
+
+template <class Key, class Comparator = std::less<Key>>
+using indexed_binary_heap = indexed_heap<Key, 2, Comparator>;
 }
 }
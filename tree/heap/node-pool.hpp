@@ -0,0 +1,74 @@
+// Data structure: Node Pool (arena)
+
+// Representation: List of fixed size blocks of nodes + free list
+
+// Description: The pointer-based heaps (fibonacci-heap.hpp,
+// pairing-heap.hpp) allocate one node per push.  A new/delete per node
+// costs more than the O(1) amortized operations they're used for, and
+// scatters the nodes all over memory.  The pool hands out nodes from big
+// blocks instead: allocate takes the next free slot of the current block
+// (or a node given back with release), and reset makes all the nodes free
+// again at once, keeping the blocks for the next run.  Nodes are never
+// destroyed one by one, so Node has to be trivially destructible.
+
+// APIs
+// allocate : a free node...................................................O(1)
+// release : give a node back for reuse.....................................O(1)
+// reset : free all the nodes, keep the memory..............................O(1)
+// allocated : nodes in use.................................................O(1)
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace clrs {
+namespace tree {
+
+template <class Node, std::size_t BlockSize = 4096> class node_pool {
+public:
+  static_assert(std::is_trivially_destructible<Node>::value,
+                "pool nodes are never destroyed one by one");
+
+  node_pool() {}
+  node_pool(const node_pool &) = delete;
+  node_pool &operator=(const node_pool &) = delete;
+
+  Node *allocate() {
+    ++_allocated;
+    if (!_free.empty()) {
+      Node *n = _free.back();
+      _free.pop_back();
+      return n;
+    }
+    if (_used == _blocks.size() * BlockSize)
+      _blocks.emplace_back(new Node[BlockSize]);
+    Node *n = &_blocks[_used / BlockSize][_used % BlockSize];
+    ++_used;
+    return n;
+  }
+
+  void release(Node *n) {
+    --_allocated;
+    _free.push_back(n);
+  }
+
+  void reset() {
+    _used = 0;
+    _allocated = 0;
+    _free.clear();
+  }
+
+  std::size_t allocated() const { return _allocated; }
+  std::size_t capacity() const { return _blocks.size() * BlockSize; }
+
+private:
+  std::vector<std::unique_ptr<Node[]>> _blocks;
+  std::size_t _used = 0; // slots taken from the blocks, free list apart
+  std::size_t _allocated = 0;
+  std::vector<Node *> _free; // released nodes
+};
+}
+}
@@ -0,0 +1,163 @@
+// Data structure: Pairing Heap (Fredman, Sedgewick, Sleator and Tarjan)
+
+// Representation: One heap ordered tree of linked nodes, each node points
+// at its first child, its next sibling and back at its previous sibling
+// (its parent for a first child).
+
+// Description: The simple cousin of the Fibonacci heap with the same API.
+// Everything is built on link: of two trees, the root of larger key
+// becomes the first child of the other.
+//  - push and meld are a single link,
+//  - decrease_key cuts the subtree of the node out of its parent's child
+//    list and links it with the root,
+//  - extract_min removes the root and links its children in two passes:
+//    left to right two by two, then the resulting trees right to left into
+//    one.  The two passes are what make the amortized bounds work.
+// Only extract_min is O(lgN) amortized for sure, decrease_key is known to
+// be between O(lglgN) and O(2^(2sqrt(lglgN))) amortized.  In practice the
+// pairing heap is usually faster than the Fibonacci heap: its nodes are
+// smaller and it does much less bookkeeping.
+//
+// Handles and pools are as in fibonacci-heap.hpp.
+
+// APIs
+// push : insert (key, value), returns its handle...........................O(1)
+// meld : move all the items of another heap (same pool) into this one......O(1)
+// decrease_key : lower the key of an item by its handle...o(lgN) amortized
+// extract_min : remove the item of smallest key, return its value
+//               ...........................................O(lgN) amortized
+// top/min_key/min_value/key/value/empty/size...............................O(1)
+
+#pragma once
+
+#include "node-pool.hpp"
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace clrs {
+namespace tree {
+
+template <class Key, class Value = int, class Comparator = std::less<Key>>
+class pairing_heap {
+  struct node {
+    Key key;
+    Value value;
+    node *child, *sibling, *prev;
+  };
+
+public:
+  using key_type = Key;
+  using value_type = Value;
+  using handle = node *;
+  using pool_type = node_pool<node>;
+
+  // with a pool of its own
+  pairing_heap() : _own(new pool_type), _pool(_own.get()) {}
+  explicit pairing_heap(pool_type &pool) : _pool(&pool) {}
+  pairing_heap(const pairing_heap &) = delete;
+  pairing_heap &operator=(const pairing_heap &) = delete;
+
+  bool empty() const { return _size == 0; }
+  std::size_t size() const { return _size; }
+  handle top() const { return _root; }
+  const Key &min_key() const { return _root->key; }
+  const Value &min_value() const { return _root->value; }
+  static const Key &key(handle h) { return h->key; }
+  static const Value &value(handle h) { return h->value; }
+
+  handle push(const Key &k, const Value &v) {
+    node *x = _pool->allocate();
+    x->key = k;
+    x->value = v;
+    x->child = x->sibling = x->prev = nullptr;
+    _root = link(_root, x);
+    ++_size;
+    return x;
+  }
+
+  void meld(pairing_heap &other) {
+    assert(_pool == other._pool);
+    _root = link(_root, other._root);
+    _size += other._size;
+    other._root = nullptr;
+    other._size = 0;
+  }
+
+  void decrease_key(handle x, const Key &k) {
+    assert(!_comp(x->key, k));
+    x->key = k;
+    if (x == _root)
+      return;
+    // cut the subtree of x out of the child list it's in
+    if (x->prev->child == x)
+      x->prev->child = x->sibling;
+    else
+      x->prev->sibling = x->sibling;
+    if (x->sibling)
+      x->sibling->prev = x->prev;
+    x->sibling = x->prev = nullptr;
+    _root = link(_root, x);
+  }
+
+  Value extract_min() {
+    assert(!empty());
+    node *r = _root;
+    // first pass, left to right: link the children two by two
+    _pairs.clear();
+    for (node *a = r->child; a;) {
+      node *b = a->sibling, *next = b ? b->sibling : nullptr;
+      a->sibling = a->prev = nullptr;
+      if (b)
+        b->sibling = b->prev = nullptr;
+      _pairs.push_back(link(a, b));
+      a = next;
+    }
+    // second pass, right to left: link them all into one
+    _root = nullptr;
+    for (auto i = _pairs.size(); i-- > 0;)
+      _root = link(_pairs[i], _root);
+    --_size;
+    Value v = r->value;
+    _pool->release(r);
+    return v;
+  }
+
+  // forgets all the items, their nodes come back with the pool's reset
+  // (right away if the heap has a pool of its own)
+  void clear() {
+    _root = nullptr;
+    _size = 0;
+    if (_own)
+      _own->reset();
+  }
+
+private:
+  // a and b are roots (no sibling), returns the root of the linked tree
+  node *link(node *a, node *b) const {
+    if (!a)
+      return b;
+    if (!b)
+      return a;
+    if (_comp(b->key, a->key))
+      std::swap(a, b);
+    b->sibling = a->child;
+    if (a->child)
+      a->child->prev = b;
+    b->prev = a;
+    a->child = b;
+    return a;
+  }
+
+  std::unique_ptr<pool_type> _own;
+  pool_type *_pool;
+  node *_root = nullptr;
+  std::size_t _size = 0;
+  Comparator _comp;
+  std::vector<node *> _pairs; // extract_min's scratch
+};
+}
+}
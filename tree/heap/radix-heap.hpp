@@ -0,0 +1,115 @@
+// Data structure: Radix Heap (Ahuja, Mehlhorn, Orlin and Tarjan)
+
+// Representation: Array of buckets, one per bit of the key + 1
+
+// Description: A monotone priority queue for integer keys: the keys pushed
+// are never smaller than the last key popped (last), which is exactly the
+// case in Dijkstra with non-negative integer weights.  An entry with key k
+// goes in bucket 0 if k == last, otherwise in bucket b, b being the
+// position of the highest bit in which k and last differ (+1).  So bucket 0
+// holds the minimums, and bucket b only keys that share their high bits
+// with last and are smaller than the keys of bucket b+1.
+// When bucket 0 runs empty, the first non-empty bucket b is emptied: its
+// smallest key becomes last and its entries are redistributed, each of them
+// lands in a bucket below b.  An entry can only move down, at most
+// (bits of the key) times, hence the O(lgC) amortized pop, C the largest
+// key difference.
+//
+// The items are the integers 0..n-1 with the same API as indexed_heap in
+// heap.hpp.  There's no decrease-key in place: decrease_key pushes a new
+// entry and the outdated one is dropped when it comes out.
+
+// APIs
+// push/decrease_key ......................................................O(1)
+// pop : the item of smallest key..............................O(lgC) amortized
+// contains/key/empty/size.................................................O(1)
+
+#pragma once
+
+#include <cassert>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace clrs {
+namespace tree {
+
+template <class Key> class radix_heap {
+public:
+  using key_type = Key;
+  static_assert(std::is_integral<Key>::value,
+                "radix_heap needs integer keys");
+  using ukey = typename std::make_unsigned<Key>::type;
+
+  explicit radix_heap(int n = 0) : _key(n), _in(n, false) {}
+
+  bool empty() const { return _size == 0; }
+  int size() const { return _size; }
+  bool contains(int i) const { return _in[i]; }
+  const Key &key(int i) const { return _key[i]; }
+
+  void push(int i, const Key &k) {
+    assert(!contains(i) && k >= _last);
+    _in[i] = true;
+    ++_size;
+    _key[i] = k;
+    _buckets[bucket(k)].emplace_back(k, i);
+  }
+
+  void decrease_key(int i, const Key &k) {
+    assert(contains(i) && k <= _key[i] && k >= _last);
+    _key[i] = k;
+    _buckets[bucket(k)].emplace_back(k, i);
+  }
+
+  int pop() {
+    assert(!empty());
+    for (;;) {
+      if (_buckets[0].empty())
+        refill();
+      auto e = _buckets[0].back();
+      _buckets[0].pop_back();
+      // skip the entries left behind by decrease_key (or popped already)
+      if (!_in[e.second] || _key[e.second] != e.first)
+        continue;
+      _in[e.second] = false;
+      --_size;
+      return e.second;
+    }
+  }
+
+private:
+  static const int bits = std::numeric_limits<ukey>::digits;
+
+  int bucket(Key k) const {
+    ukey diff = static_cast<ukey>(k) ^ static_cast<ukey>(_last);
+    if (diff == 0)
+      return 0;
+    // position of the highest set bit, + 1
+    return std::numeric_limits<unsigned long long>::digits -
+           __builtin_clzll(static_cast<unsigned long long>(diff));
+  }
+
+  void refill() {
+    int b = 1;
+    while (_buckets[b].empty())
+      ++b;
+    Key smallest = _buckets[b].front().first;
+    for (auto &e : _buckets[b])
+      if (e.first < smallest)
+        smallest = e.first;
+    _last = smallest;
+    for (auto &e : _buckets[b])
+      _buckets[bucket(e.first)].push_back(e);
+    _buckets[b].clear();
+  }
+
+  std::vector<std::pair<Key, int>> _buckets[bits + 1];
+  std::vector<Key> _key;
+  std::vector<bool> _in;
+  Key _last = 0;
+  int _size = 0;
+};
+}
+}
@@ -0,0 +1,119 @@
+// timing helpers for the benchmark programs
+//
+// stopwatch and best_time time a piece of code, peak_memory_bytes tells
+// how much memory the process ever had resident, and bench_log collects
+// the measurements of a run as rows that can be printed as a table or
+// written as CSV or JSON, so that runs of two versions of the code can be
+// compared by a script.
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+namespace clrs {
+namespace util {
+
+class stopwatch {
+public:
+  stopwatch() : _start(clock::now()) {}
+  void restart() { _start = clock::now(); }
+  double seconds() const {
+    return std::chrono::duration<double>(clock::now() - _start).count();
+  }
+
+private:
+  using clock = std::chrono::steady_clock;
+  clock::time_point _start;
+};
+
+// Best of `repeat` runs of f, in seconds.  The best run is the one least
+// disturbed by the rest of the machine.
+template <class F> double best_time(int repeat, F &&f) {
+  double best = 1e300;
+  for (int i = 0; i < repeat; ++i) {
+    stopwatch w;
+    f();
+    double t = w.seconds();
+    if (t < best)
+      best = t;
+  }
+  return best;
+}
+
+// the high-water mark of the resident memory of the process (getrusage),
+// it never goes down: run the big inputs last
+inline std::size_t peak_memory_bytes() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+  return static_cast<std::size_t>(usage.ru_maxrss) * 1024; // KB on Linux
+}
+
+// one measurement
+struct bench_row {
+  std::string suite;     // bfs, scc, mst...
+  std::string algorithm; // the function measured
+  std::string input;     // the generator and its size
+  int threads;
+  double seconds;
+  double items;          // edges (TEPS), elements or operations
+  std::size_t peak_bytes;
+
+  double rate() const { return seconds > 0 ? items / seconds : 0; }
+};
+
+class bench_log {
+public:
+  // peak memory is sampled when the row is added
+  void add(const std::string &suite, const std::string &algorithm,
+           const std::string &input, int threads, double seconds,
+           double items) {
+    rows.push_back(bench_row{suite, algorithm, input, threads, seconds, items,
+                             peak_memory_bytes()});
+  }
+
+  static void print_header(std::FILE *out = stdout) {
+    std::fprintf(out, "%-10s %-26s %-22s %7s %10s %12s %9s\n", "suite",
+                 "algorithm", "input", "threads", "seconds", "Mitems/s",
+                 "peak MB");
+  }
+  static void print(const bench_row &r, std::FILE *out = stdout) {
+    std::fprintf(out, "%-10s %-26s %-22s %7d %10.4f %12.2f %9.1f\n",
+                 r.suite.c_str(), r.algorithm.c_str(), r.input.c_str(),
+                 r.threads, r.seconds, r.rate() / 1e6,
+                 r.peak_bytes / 1048576.0);
+  }
+
+  void write_csv(std::ostream &out) const {
+    out << "suite,algorithm,input,threads,seconds,items,items_per_second,"
+           "peak_bytes\n";
+    for (auto &r : rows)
+      out << r.suite << ',' << r.algorithm << ',' << r.input << ','
+          << r.threads << ',' << r.seconds << ',' << r.items << ','
+          << r.rate() << ',' << r.peak_bytes << '\n';
+  }
+
+  // the names are plain identifiers, nothing to escape
+  void write_json(std::ostream &out) const {
+    out << "[\n";
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+      auto &r = rows[i];
+      out << "  {\"suite\": \"" << r.suite << "\", \"algorithm\": \""
+          << r.algorithm << "\", \"input\": \"" << r.input
+          << "\", \"threads\": " << r.threads << ", \"seconds\": " << r.seconds
+          << ", \"items\": " << r.items << ", \"items_per_second\": "
+          << r.rate() << ", \"peak_bytes\": " << r.peak_bytes << "}"
+          << (i + 1 < rows.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+  }
+
+  std::vector<bench_row> rows;
+};
+}
+}
@@ -0,0 +1,90 @@
+// a read-only memory mapping of a whole file
+//
+// The pages are loaded by the kernel on first touch and shared with the
+// page cache, so opening a file that's already in the cache costs the same
+// whatever its size: no read, no copy.  The mapping lives as long as the
+// mapped_file object (movable, not copyable).
+//
+// POSIX only (mmap).
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace clrs {
+namespace util {
+
+class mapped_file {
+public:
+  mapped_file() {}
+  // throws std::runtime_error if the file can't be opened or mapped
+  explicit mapped_file(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      fail(path, "open", errno);
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      int err = errno;
+      ::close(fd);
+      fail(path, "stat", err);
+    }
+    _size = static_cast<std::size_t>(st.st_size);
+    if (_size > 0) {
+      void *p = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        int err = errno;
+        ::close(fd);
+        fail(path, "mmap", err);
+      }
+      _data = static_cast<const char *>(p);
+    }
+    // the mapping keeps the file alive
+    ::close(fd);
+  }
+  mapped_file(const mapped_file &) = delete;
+  mapped_file &operator=(const mapped_file &) = delete;
+  mapped_file(mapped_file &&other) noexcept { swap(other); }
+  mapped_file &operator=(mapped_file &&other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~mapped_file() {
+    if (_data)
+      ::munmap(const_cast<char *>(_data), _size);
+  }
+
+  const char *data() const { return _data; }
+  std::size_t size() const { return _size; }
+
+  // hints that the whole file is going to be read, in order
+  void will_read_sequentially() const {
+    if (_data) {
+      ::madvise(const_cast<char *>(_data), _size, MADV_SEQUENTIAL);
+      ::madvise(const_cast<char *>(_data), _size, MADV_WILLNEED);
+    }
+  }
+
+private:
+  static void fail(const std::string &path, const char *what, int err) {
+    throw std::runtime_error(path + ": " + what + " failed: " +
+                             std::strerror(err));
+  }
+
+  void swap(mapped_file &other) {
+    std::swap(_data, other._data);
+    std::swap(_size, other._size);
+  }
+
+  const char *_data = nullptr;
+  std::size_t _size = 0;
+};
+}
+}
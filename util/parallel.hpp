@@ -0,0 +1,198 @@
+// small fork-join helpers shared by the parallel algorithms
+//
+// thread_pool keeps its worker threads alive between parallel regions:
+// run(f) calls f(tid) once on every thread of the pool (the calling thread
+// is tid 0) and returns when they're all done.  Algorithms working level
+// by level (bfs, delta-stepping, bellman-ford rounds...) call run() once
+// per level without paying for thread creation each time.
+//
+// Built on std::thread only, compile with -pthread.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace clrs {
+namespace util {
+
+using std::size_t;
+
+inline int hardware_threads() {
+  int n = static_cast<int>(std::thread::hardware_concurrency());
+  return n > 0 ? n : 1;
+}
+
+class thread_pool {
+public:
+  explicit thread_pool(int threads = hardware_threads())
+      : _size(std::max(threads, 1)) {
+    for (int tid = 1; tid < _size; ++tid)
+      _workers.emplace_back([this, tid] { work(tid); });
+  }
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(_m);
+      _stop = true;
+    }
+    _start.notify_all();
+    for (auto &t : _workers)
+      t.join();
+  }
+
+  int size() const { return _size; }
+
+  template <class F> void run(F &&f) {
+    if (_size == 1) {
+      f(0);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(_m);
+      _job = std::ref(f);
+      _pending = _size - 1;
+      ++_generation;
+    }
+    _start.notify_all();
+    f(0);
+    std::unique_lock<std::mutex> lock(_m);
+    _done.wait(lock, [this] { return _pending == 0; });
+  }
+
+private:
+  void work(int tid) {
+    size_t seen = 0;
+    for (;;) {
+      std::function<void(int)> job;
+      {
+        std::unique_lock<std::mutex> lock(_m);
+        _start.wait(lock, [&] { return _stop || _generation != seen; });
+        if (_stop)
+          return;
+        seen = _generation;
+        job = _job;
+      }
+      job(tid);
+      std::lock_guard<std::mutex> lock(_m);
+      if (--_pending == 0)
+        _done.notify_one();
+    }
+  }
+
+  int _size;
+  std::vector<std::thread> _workers;
+  std::mutex _m;
+  std::condition_variable _start, _done;
+  std::function<void(int)> _job;
+  size_t _generation = 0;
+  int _pending = 0;
+  bool _stop = false;
+};
+
+// Static partition of [first, last) into one contiguous block per thread,
+// f(lo, hi, tid) is called for each non-empty block.
+template <class F>
+void parallel_for(thread_pool &pool, size_t first, size_t last, F &&f) {
+  size_t n = last - first, threads = pool.size();
+  pool.run([&](int tid) {
+    size_t lo = first + n * tid / threads, hi = first + n * (tid + 1) / threads;
+    if (lo < hi)
+      f(lo, hi, tid);
+  });
+}
+
+// Dynamic partition: the threads grab blocks of grain indices until
+// [first, last) is exhausted.  Better when the cost per index is skewed
+// (a frontier with a few very high degree vertices, say).
+template <class F>
+void parallel_for_dynamic(thread_pool &pool, size_t first, size_t last,
+                          size_t grain, F &&f) {
+  std::atomic<size_t> next(first);
+  pool.run([&](int tid) {
+    for (;;) {
+      size_t lo = next.fetch_add(grain, std::memory_order_relaxed);
+      if (lo >= last)
+        return;
+      f(lo, std::min(lo + grain, last), tid);
+    }
+  });
+}
+// Sorts [first, last): one block per thread sorted with std::sort, then the
+// sorted runs merged pairwise, half of the threads busy at the first merge
+// level, a quarter at the next...
+template <class It, class Compare>
+void parallel_sort(thread_pool &pool, It first, It last, Compare comp) {
+  size_t n = last - first, threads = pool.size();
+  if (threads == 1 || n < (1 << 14)) {
+    std::sort(first, last, comp);
+    return;
+  }
+  std::vector<size_t> bound(threads + 1);
+  for (size_t t = 0; t <= threads; ++t)
+    bound[t] = n * t / threads;
+  pool.run([&](int tid) {
+    std::sort(first + bound[tid], first + bound[tid + 1], comp);
+  });
+  for (size_t width = 1; width < threads; width *= 2)
+    pool.run([&](int tid) {
+      size_t t = tid;
+      if (t % (2 * width) != 0 || t + width >= threads)
+        return;
+      std::inplace_merge(first + bound[t], first + bound[t + width],
+                         first + bound[std::min(t + 2 * width, threads)],
+                         comp);
+    });
+}
+// Stable partition of v[first, last) on pred, returns the index of the
+// first element for which pred is false.  Each thread evaluates pred on
+// its block (once per element, the answers are kept) and counts the
+// elements going left, a prefix sum gives every block where to write, then
+// the blocks are scattered into a buffer and copied back.
+template <class T, class Pred>
+size_t parallel_partition(thread_pool &pool, std::vector<T> &v, size_t first,
+                          size_t last, Pred pred) {
+  size_t n = last - first, threads = pool.size();
+  if (threads == 1 || n < (1 << 14))
+    return std::stable_partition(v.begin() + first, v.begin() + last, pred) -
+           v.begin();
+  std::vector<size_t> bound(threads + 1), left(threads + 1, 0);
+  for (size_t t = 0; t <= threads; ++t)
+    bound[t] = first + n * t / threads;
+  std::vector<char> goes_left(n);
+  pool.run([&](int tid) {
+    size_t c = 0;
+    for (size_t i = bound[tid]; i < bound[tid + 1]; ++i) {
+      goes_left[i - first] = pred(v[i]) ? 1 : 0;
+      c += goes_left[i - first];
+    }
+    left[tid + 1] = c;
+  });
+  for (size_t t = 0; t < threads; ++t)
+    left[t + 1] += left[t];
+  std::vector<T> out(n);
+  pool.run([&](int tid) {
+    // the trues go after those of the previous blocks, the falses after
+    // all the trues and the falses of the previous blocks
+    size_t l = left[tid], r = left[threads] + (bound[tid] - first) - left[tid];
+    for (size_t i = bound[tid]; i < bound[tid + 1]; ++i) {
+      if (goes_left[i - first])
+        out[l++] = v[i];
+      else
+        out[r++] = v[i];
+    }
+  });
+  pool.run([&](int tid) {
+    size_t lo = n * tid / threads, hi = n * (tid + 1) / threads;
+    std::copy(out.begin() + lo, out.begin() + hi, v.begin() + first + lo);
+  });
+  return first + left[threads];
+}
+}
+}
@@ -0,0 +1,146 @@
+// a string interner: each distinct string stored once, known by a dense id
+//
+// intern(s) returns the id of s, 0, 1, 2... in order of first appearance,
+// copying s only the first time it's seen.  The copies go into an arena:
+// big blocks of chars filled one string after the other (each followed by
+// a '\0'), never moved nor freed before the interner, so c_str(id) stays
+// valid and millions of names cost millions of small copies in a few
+// allocations, without the per-string header and heap block of a
+// std::string.
+//
+// The index from the strings to their ids is an open addressing hash table
+// of ids (linear probing, at most half full), the hash of each string kept
+// next to it so that growing the table never hashes again.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clrs {
+namespace util {
+
+class string_interner {
+public:
+  explicit string_interner(std::size_t block_size = 1 << 16)
+      : _block_size(block_size), _table(16, -1) {}
+
+  int size() const { return static_cast<int>(_entries.size()); }
+  const char *c_str(int id) const { return _entries[id].s; }
+  std::size_t length(int id) const { return _entries[id].length; }
+  std::string str(int id) const {
+    return std::string(_entries[id].s, _entries[id].length);
+  }
+
+  // the id of s, a new one if s wasn't seen before
+  int intern(const char *s, std::size_t n) {
+    auto h = hash(s, n);
+    auto slot = probe(s, n, h);
+    if (_table[slot] >= 0)
+      return _table[slot];
+    int id = size();
+    _entries.push_back(entry{store(s, n), static_cast<std::uint32_t>(n), h});
+    _table[slot] = id;
+    if (2 * _entries.size() > _table.size())
+      grow();
+    return id;
+  }
+  int intern(const std::string &s) { return intern(s.data(), s.size()); }
+
+  // the id of s, -1 if it's not there
+  int find(const char *s, std::size_t n) const {
+    return _table[probe(s, n, hash(s, n))];
+  }
+  int find(const std::string &s) const { return find(s.data(), s.size()); }
+
+  void reserve(std::size_t names) {
+    _entries.reserve(names);
+    while (_table.size() < 2 * names)
+      grow();
+  }
+
+  // the memory held: arena, entries and table
+  std::size_t memory_bytes() const {
+    return _arena_bytes + _entries.capacity() * sizeof(entry) +
+           _table.capacity() * sizeof(int);
+  }
+
+private:
+  struct entry {
+    const char *s;
+    std::uint32_t length;
+    std::uint32_t hash;
+  };
+
+  // FNV-1a
+  static std::uint32_t hash(const char *s, std::size_t n) {
+    std::uint32_t h = 2166136261u;
+    for (std::size_t i = 0; i < n; ++i)
+      h = (h ^ static_cast<unsigned char>(s[i])) * 16777619u;
+    return h;
+  }
+
+  // the slot of s, or the empty slot where it would go
+  std::size_t probe(const char *s, std::size_t n, std::uint32_t h) const {
+    std::size_t mask = _table.size() - 1;
+    for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+      int id = _table[i];
+      if (id < 0)
+        return i;
+      auto &e = _entries[id];
+      if (e.hash == h && e.length == n && std::memcmp(e.s, s, n) == 0)
+        return i;
+    }
+  }
+
+  void grow() {
+    std::vector<int> table(2 * _table.size(), -1);
+    std::size_t mask = table.size() - 1;
+    for (int id = 0; id < size(); ++id) {
+      std::size_t i = _entries[id].hash & mask;
+      while (table[i] >= 0)
+        i = (i + 1) & mask;
+      table[i] = id;
+    }
+    _table.swap(table);
+  }
+
+  // a copy of s in the arena, a block of its own if it's bigger than a
+  // block
+  const char *store(const char *s, std::size_t n) {
+    if (n + 1 > _left) {
+      std::size_t size = std::max(_block_size, n + 1);
+      _blocks.emplace_back(new char[size]);
+      _arena_bytes += size;
+      if (size > _block_size)
+        // keep filling the current block
+        return copy(_blocks.back().get(), s, n);
+      _next = _blocks.back().get();
+      _left = size;
+    }
+    auto p = copy(_next, s, n);
+    _next += n + 1;
+    _left -= n + 1;
+    return p;
+  }
+
+  static const char *copy(char *to, const char *s, std::size_t n) {
+    std::memcpy(to, s, n);
+    to[n] = '\0';
+    return to;
+  }
+
+  std::size_t _block_size;
+  std::vector<std::unique_ptr<char[]>> _blocks;
+  char *_next = nullptr;
+  std::size_t _left = 0;
+  std::size_t _arena_bytes = 0;
+  std::vector<entry> _entries; // by id
+  std::vector<int> _table;     // ids, -1: empty
+};
+}
+}